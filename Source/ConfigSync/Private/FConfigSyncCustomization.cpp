@@ -2,8 +2,11 @@
 
 #include "DetailLayoutBuilder.h"
 #include "DetailWidgetRow.h"
+#include "Framework/Notifications/NotificationManager.h"
 #include "Macros.h"
 #include "UConfigSyncSettings.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Widgets/Notifications/SProgressBar.h"
 
 #define LOCTEXT_NAMESPACE "ConfigSyncCustomization"
 
@@ -20,6 +23,8 @@ void FConfigSyncCustomization::CustomizeDetails( IDetailLayoutBuilder& DetailBui
 	TSharedRef< IPropertyHandle > StructHandle    = DetailBuilder.GetProperty( GET_MEMBER_NAME_CHECKED( UConfigSyncSettings, ConfigFileSettingsStruct ) );
 	IDetailCategoryBuilder&       ActionsCategory = DetailBuilder.EditCategory( "Actions", FText::FromString( "Actions" ), ECategoryPriority::Important );
 
+	const TWeakPtr< IPropertyHandle > WeakStructHandle = StructHandle;
+
 	ActionsCategory.AddCustomRow( LOCTEXT( "SyncActionsRow", "Sync Actions" ) ).WholeRowContent()
 	[
 		SNew( SHorizontalBox )
@@ -31,12 +36,16 @@ void FConfigSyncCustomization::CustomizeDetails( IDetailLayoutBuilder& DetailBui
 			SNew( SButton )
 			.Text( LOCTEXT( "DiscoverFiles", "Discover New Config Files" ) )
 			.ToolTipText( LOCTEXT( "DiscoverFilesTooltip", "Scan the project and add all new .ini files to the sync list" ) )
-			.OnClicked_Lambda( [this, StructHandle]
+			.IsEnabled( this, &FConfigSyncCustomization::CanStartOperation )
+			.OnClicked_Lambda( [this, WeakStructHandle]
 			{
 				if( UConfigSyncSettings* Config = ConfigObject.Get() )
 				{
-					Config->DiscoverAndAddConfigFiles();
-					StructHandle->NotifyFinishedChangingProperties();
+					Config->DiscoverAndAddConfigFilesAsync( [WeakStructHandle]
+					{
+						if( const TSharedPtr< IPropertyHandle > Handle = WeakStructHandle.Pin() )
+							Handle->NotifyFinishedChangingProperties();
+					} );
 				}
 				return FReply::Handled();
 			} )
@@ -49,10 +58,16 @@ void FConfigSyncCustomization::CustomizeDetails( IDetailLayoutBuilder& DetailBui
 			SNew( SButton )
 			.Text( LOCTEXT( "SaveToGlobal", "Save to Global" ) )
 			.ToolTipText( LOCTEXT( "SaveToGlobalTooltip", "Save enabled config files to their global sync locations" ) )
+			.IsEnabled( this, &FConfigSyncCustomization::CanStartOperation )
 			.OnClicked_Lambda( [this]
 			{
 				if( UConfigSyncSettings* Config = ConfigObject.Get() )
-					Config->SaveSettingsToGlobal();
+				{
+					Config->SaveSettingsToGlobalAsync( [WeakTreeView = GetWeakTreeView()]
+					{
+						RequestTreeRefresh( WeakTreeView );
+					} );
+				}
 				return FReply::Handled();
 			} )
 		]
@@ -63,16 +78,98 @@ void FConfigSyncCustomization::CustomizeDetails( IDetailLayoutBuilder& DetailBui
 		[
 			SNew( SButton )
 			.Text( LOCTEXT( "LoadFromGlobal", "Load from Global" ) )
-			.ToolTipText( LOCTEXT( "LoadFromGlobalTooltip", "Load config files from their global sync locations. Restart may be required." ) )
+			.ToolTipText( LOCTEXT( "LoadFromGlobalTooltip", "Load config files from their global sync locations. Changes that cannot be hot-applied require a restart." ) )
+			.IsEnabled( this, &FConfigSyncCustomization::CanStartOperation )
+			.OnClicked_Lambda( [this]
+			{
+				if( UConfigSyncSettings* Config = ConfigObject.Get() )
+				{
+					Config->LoadSettingsFromGlobalAsync( [WeakTreeView = GetWeakTreeView()]( const FConfigSyncHotApplyResult& Result )
+					{
+						ShowHotApplyNotification( Result );
+						RequestTreeRefresh( WeakTreeView );
+					} );
+				}
+				return FReply::Handled();
+			} )
+		]
+
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.Padding( 2 )
+		[
+			SNew( SButton )
+			.Text( LOCTEXT( "FanOutToProjects", "Fan Out to Projects" ) )
+			.ToolTipText( LOCTEXT( "FanOutToProjectsTooltip", "Save to global, then apply the saved files to every other registered project that syncs them with the same scope" ) )
+			.IsEnabled( this, &FConfigSyncCustomization::CanStartOperation )
 			.OnClicked_Lambda( [this]
 			{
 				if( UConfigSyncSettings* Config = ConfigObject.Get() )
-					Config->LoadSettingsFromGlobal();
+					Config->FanOutToProjectsAsync( &FConfigSyncCustomization::ShowFanOutNotification );
 				return FReply::Handled();
 			} )
 		]
 	];
 
+	ActionsCategory.AddCustomRow( LOCTEXT( "SyncProgressRow", "Sync Progress" ) )
+	.Visibility( TAttribute< EVisibility >::CreateLambda( [this]
+	{
+		return GetActiveOperation().IsValid() ? EVisibility::Visible : EVisibility::Collapsed;
+	} ) )
+	.WholeRowContent()
+	[
+		SNew( SHorizontalBox )
+
+		+ SHorizontalBox::Slot()
+		.FillWidth( 1 )
+		.Padding( 2 )
+		.VAlign( VAlign_Center )
+		[
+			SNew( SProgressBar )
+			.Percent_Lambda( [this]
+			{
+				const TSharedPtr< FConfigSyncOperation > Operation = GetActiveOperation();
+				return Operation.IsValid() ? Operation->GetProgressFraction() : TOptional< float >();
+			} )
+		]
+
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.Padding( 8, 0 )
+		.VAlign( VAlign_Center )
+		[
+			SNew( STextBlock )
+			.Text_Lambda( [this]
+			{
+				const TSharedPtr< FConfigSyncOperation > Operation = GetActiveOperation();
+				return Operation.IsValid() ? Operation->GetProgressText() : FText::GetEmpty();
+			} )
+			.Font( IDetailLayoutBuilder::GetDetailFont() )
+		]
+
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.Padding( 2 )
+		[
+			SNew( SButton )
+			.Text( LOCTEXT( "CancelOperation", "Cancel" ) )
+			.ToolTipText( LOCTEXT( "CancelOperationTooltip", "Stop the running operation after the current file" ) )
+			.OnClicked_Lambda( [this]
+			{
+				if( const TSharedPtr< FConfigSyncOperation > Operation = GetActiveOperation() )
+					Operation->Cancel();
+				return FReply::Handled();
+			} )
+		]
+	];
+
+	IDetailCategoryBuilder& OptionsCategory = DetailBuilder.EditCategory( "Options", LOCTEXT( "Options", "Options" ), ECategoryPriority::Important );
+	AddOptionProperty( OptionsCategory, StructHandle, GET_MEMBER_NAME_CHECKED( FConfigFileSettingsStruct, bHotApplyOnLoad ) );
+	AddOptionProperty( OptionsCategory, StructHandle, GET_MEMBER_NAME_CHECKED( FConfigFileSettingsStruct, KeyRules ) );
+	AddOptionProperty( OptionsCategory, StructHandle, GET_MEMBER_NAME_CHECKED( FConfigFileSettingsStruct, AutoSyncMinInterval ) );
+	AddOptionProperty( OptionsCategory, StructHandle, GET_MEMBER_NAME_CHECKED( FConfigFileSettingsStruct, AutoSyncMaxInterval ) );
+	AddOptionProperty( OptionsCategory, StructHandle, GET_MEMBER_NAME_CHECKED( FConfigFileSettingsStruct, AutoSyncFilesPerTick ) );
+
 	DetailBuilder.HideProperty( StructHandle );
 
 	RefreshTreeData( DetailBuilder );
@@ -88,6 +185,80 @@ void FConfigSyncCustomization::CustomizeDetails( IDetailLayoutBuilder& DetailBui
 	];
 }
 
+void FConfigSyncCustomization::AddOptionProperty( IDetailCategoryBuilder& Category, const TSharedRef< IPropertyHandle >& StructHandle, const FName PropertyName )
+{
+	TRACE_CPU_SCOPE;
+
+	const TSharedPtr< IPropertyHandle > PropertyHandle = StructHandle->GetChildHandle( PropertyName );
+	if( !PropertyHandle.IsValid() )
+		return;
+
+	const FSimpleDelegate OnValueChanged = FSimpleDelegate::CreateLambda( [this]
+	{
+		if( UConfigSyncSettings* Config = ConfigObject.Get() )
+			Config->OnSettingsChanged();
+	} );
+	PropertyHandle->SetOnPropertyValueChanged( OnValueChanged );
+	PropertyHandle->SetOnChildPropertyValueChanged( OnValueChanged );
+	Category.AddProperty( PropertyHandle ).IsEnabled( TAttribute< bool >::CreateLambda( [this] { return CanStartOperation(); } ) );
+}
+
+bool FConfigSyncCustomization::CanStartOperation() const
+{
+	return ConfigObject.IsValid() && !ConfigObject->IsOperationRunning();
+}
+
+TSharedPtr< FConfigSyncOperation > FConfigSyncCustomization::GetActiveOperation() const
+{
+	return ConfigObject.IsValid() ? ConfigObject->GetActiveOperation() : nullptr;
+}
+
+void FConfigSyncCustomization::RequestTreeRefresh( const TWeakPtr< STreeView< TSharedRef< FConfigTreeItem > > >& WeakTreeView )
+{
+	TRACE_CPU_SCOPE;
+
+	if( const TSharedPtr< STreeView< TSharedRef< FConfigTreeItem > > > PinnedTreeView = WeakTreeView.Pin() )
+		PinnedTreeView->RequestTreeRefresh();
+}
+
+void FConfigSyncCustomization::ShowHotApplyNotification( const FConfigSyncHotApplyResult& Result )
+{
+	TRACE_CPU_SCOPE;
+
+	if( Result.AppliedSections.IsEmpty() && Result.RestartRequired.IsEmpty() )
+		return;
+
+	FNotificationInfo Info( FText::Format( LOCTEXT( "HotApplyResult", "Hot-applied {0} section(s), {1} change(s) require a restart" ),
+	                                       Result.AppliedSections.Num(),
+	                                       Result.RestartRequired.Num() ) );
+	Info.ExpireDuration = 5.0f;
+	if( !Result.RestartRequired.IsEmpty() )
+		Info.SubText = FText::FromString( FString::Join( Result.RestartRequired, TEXT( "\n" ) ) );
+
+	FSlateNotificationManager::Get().AddNotification( Info );
+}
+
+void FConfigSyncCustomization::ShowFanOutNotification( const TArray< FConfigSyncFanOutResult >& Results )
+{
+	TRACE_CPU_SCOPE;
+
+	int32             FilesApplied = 0;
+	int32             FilesFailed  = 0;
+	TArray< FString > ProjectLines;
+	for( const FConfigSyncFanOutResult& Result: Results )
+	{
+		FilesApplied += Result.FilesApplied;
+		FilesFailed  += Result.FilesFailed;
+		ProjectLines.Add( FString::Printf( TEXT( "%s: %d applied, %d failed" ), *Result.ProjectName, Result.FilesApplied, Result.FilesFailed ) );
+	}
+
+	FNotificationInfo Info( FText::Format( LOCTEXT( "FanOutResult", "Fanned out to {0} project(s): {1} file(s) applied, {2} failed" ), Results.Num(), FilesApplied, FilesFailed ) );
+	Info.ExpireDuration = 5.0f;
+	Info.SubText        = FText::FromString( FString::Join( ProjectLines, TEXT( "\n" ) ) );
+
+	FSlateNotificationManager::Get().AddNotification( Info );
+}
+
 void FConfigSyncCustomization::RefreshTreeData( const IDetailLayoutBuilder& DetailBuilder )
 {
 	TRACE_CPU_SCOPE;
@@ -200,6 +371,7 @@ TSharedRef< ITableRow > FConfigSyncCustomization::OnGenerateRow( TSharedRef< FCo
 				.VAlign( VAlign_Center )
 				[
 					SNew( SCheckBox )
+					.IsEnabled_Lambda( [this] { return CanStartOperation(); } )
 					.IsChecked_Lambda( [InItem]
 					{
 						bool bVal = false;
@@ -303,6 +475,7 @@ TSharedRef< ITableRow > FConfigSyncCustomization::OnGenerateRow( TSharedRef< FCo
 	return SNew( STableRow< TSharedRef< FConfigTreeItem > >, OwnerTable )
 		[
 			SNew( SVerticalBox )
+			.IsEnabled_Lambda( [this] { return CanStartOperation(); } )
 
 			+ SVerticalBox::Slot()
 			.AutoHeight()
@@ -0,0 +1,99 @@
+#include "FConfigSyncHotApply.h"
+
+#include "FConfigSync.h"
+#include "FConfigSyncIni.h"
+#include "Macros.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/ConfigContext.h"
+#include "Misc/ConfigUtilities.h"
+
+bool FConfigSyncHotApply::CollectChanges( const FString& FilePath, const FString& OldContents, const FString& NewContents, FConfigSyncFileChanges& OutChanges )
+{
+	TRACE_CPU_SCOPE;
+
+	TArray< FConfigSyncIniSection > OldSections;
+	TArray< FConfigSyncIniSection > NewSections;
+	FConfigSyncIni::Parse( OldContents, OldSections );
+	FConfigSyncIni::Parse( NewContents, NewSections );
+
+	OutChanges.FilePath = FilePath;
+	OutChanges.ChangedKeys.Reset();
+	FConfigSyncIni::Diff( OldSections, NewSections, OutChanges.ChangedKeys );
+
+	return !OutChanges.ChangedKeys.IsEmpty();
+}
+
+void FConfigSyncHotApply::Apply( const TArray< FConfigSyncFileChanges >& Changes, FConfigSyncHotApplyResult& OutResult )
+{
+	TRACE_CPU_SCOPE;
+
+	auto AddRestartRequired = [&OutResult]( const FString& BranchName, const FString& SectionName, const TSet< FString >& Keys )
+	{
+		for( const FString& Key: Keys )
+			OutResult.RestartRequired.Add( FString::Printf( TEXT( "%s [%s] %s" ), *BranchName, *SectionName, *Key ) );
+	};
+
+	for( const FConfigSyncFileChanges& Change: Changes )
+	{
+		const FString BranchName = GetBranchName( Change.FilePath );
+		if( !GConfig || !GConfig->FindConfigFileWithBaseName( *BranchName ) || !FConfigContext::ForceReloadIntoGConfig().Load( *BranchName ) )
+		{
+			for( const TPair< FString, TSet< FString > >& Section: Change.ChangedKeys )
+				AddRestartRequired( BranchName, Section.Key, Section.Value );
+			continue;
+		}
+
+		const FString BranchFilename = GConfig->GetConfigFilename( *BranchName );
+		for( const TPair< FString, TSet< FString > >& Section: Change.ChangedKeys )
+		{
+			if( ApplySection( BranchFilename, Section.Key ) )
+				OutResult.AppliedSections.Add( FString::Printf( TEXT( "%s [%s]" ), *BranchName, *Section.Key ) );
+			else
+				AddRestartRequired( BranchName, Section.Key, Section.Value );
+		}
+	}
+
+	for( const FString& Applied: OutResult.AppliedSections )
+		UE_LOG( LogConfigSync, Log, TEXT( "Hot-applied: %s" ), *Applied );
+
+	for( const FString& Pending: OutResult.RestartRequired )
+		UE_LOG( LogConfigSync, Warning, TEXT( "Restart required: %s" ), *Pending );
+}
+
+bool FConfigSyncHotApply::ApplySection( const FString& BranchFilename, const FString& SectionName )
+{
+	TRACE_CPU_SCOPE;
+
+	if( SectionName == TEXT( "ConsoleVariables" ) )
+	{
+		UE::ConfigUtilities::ApplyCVarSettingsFromIni( *SectionName, *BranchFilename, ECVF_SetByConsoleVariablesIni );
+		return true;
+	}
+
+	if( SectionName == TEXT( "SystemSettings" ) )
+	{
+		UE::ConfigUtilities::ApplyCVarSettingsFromIni( *SectionName, *BranchFilename, ECVF_SetBySystemSettingsIni );
+		return true;
+	}
+
+	if( !SectionName.StartsWith( TEXT( "/Script/" ) ) )
+		return false;
+
+	UClass* Class = FindObject< UClass >( nullptr, *SectionName );
+	if( !Class || !Class->HasAnyClassFlags( CLASS_Config ) )
+		return false;
+
+	Class->GetDefaultObject()->ReloadConfig();
+	return true;
+}
+
+FString FConfigSyncHotApply::GetBranchName( const FString& FilePath )
+{
+	TRACE_CPU_SCOPE;
+
+	FString BaseName = FPaths::GetBaseFilename( FilePath );
+	if( !BaseName.RemoveFromStart( TEXT( "Default" ) ) )
+		BaseName.RemoveFromStart( FPlatformProperties::IniPlatformName() );
+
+	return BaseName;
+}
\ No newline at end of file
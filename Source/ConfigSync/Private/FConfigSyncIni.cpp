@@ -0,0 +1,327 @@
+#include "FConfigSyncIni.h"
+
+#include "FConfigSyncKeyFilter.h"
+#include "Hash/CityHash.h"
+#include "Macros.h"
+#include "String/ParseLines.h"
+
+void FConfigSyncIni::Stream( const FStringView Contents, const TFunctionRef< void( const FConfigSyncIniLine& ) > Visitor )
+{
+	TRACE_CPU_SCOPE;
+
+	FStringView CurrentSection;
+
+	auto VisitLine = [&]( const FStringView Line )
+	{
+		FConfigSyncIniLine IniLine{};
+		IniLine.Line = Line;
+
+		const FStringView Trimmed = Line.TrimStartAndEnd();
+		if( Trimmed.IsEmpty() )
+			IniLine.Token = EConfigSyncIniToken::Blank;
+		else if( Trimmed[ 0 ] == TEXT( ';' ) || Trimmed[ 0 ] == TEXT( '#' ) )
+			IniLine.Token = EConfigSyncIniToken::Comment;
+		else if( Trimmed[ 0 ] == TEXT( '[' ) && Trimmed[ Trimmed.Len() - 1 ] == TEXT( ']' ) )
+		{
+			IniLine.Token  = EConfigSyncIniToken::Section;
+			CurrentSection = Trimmed.Mid( 1, Trimmed.Len() - 2 ).TrimStartAndEnd();
+		}
+		else
+		{
+			IniLine.Token = EConfigSyncIniToken::Entry;
+
+			int32 EqualsIndex = INDEX_NONE;
+			if( Trimmed.FindChar( TEXT( '=' ), EqualsIndex ) )
+			{
+				IniLine.Key   = Trimmed.Left( EqualsIndex ).TrimEnd();
+				IniLine.Value = Trimmed.Mid( EqualsIndex + 1 ).TrimStart();
+			}
+			else
+				IniLine.Key = Trimmed;
+		}
+
+		IniLine.Section = CurrentSection;
+		Visitor( IniLine );
+	};
+
+	UE::String::ParseLines( Contents, VisitLine, UE::String::EParseLinesOptions::None );
+}
+
+void FConfigSyncIni::Parse( const FString& Contents, TArray< FConfigSyncIniSection >& OutSections )
+{
+	TRACE_CPU_SCOPE;
+
+	OutSections.Reset();
+
+	TMap< FString, int32 > SectionIndices;
+	int32                  CurrentSection = INDEX_NONE;
+
+	auto VisitLine = [&]( const FConfigSyncIniLine& Line )
+	{
+		if( Line.Token == EConfigSyncIniToken::Section )
+		{
+			const FString SectionName( Line.Section );
+			if( const int32* ExistingIndex = SectionIndices.Find( SectionName ) )
+			{
+				CurrentSection = *ExistingIndex;
+				return;
+			}
+
+			CurrentSection                         = OutSections.Num();
+			OutSections.AddDefaulted_GetRef().Name = SectionName;
+			SectionIndices.Add( SectionName, CurrentSection );
+		}
+		else if( Line.Token == EConfigSyncIniToken::Entry && CurrentSection != INDEX_NONE )
+			OutSections[ CurrentSection ].Entries.Add( { FString( Line.Key ), FString( Line.Value ) } );
+	};
+
+	Stream( Contents, VisitLine );
+}
+
+void FConfigSyncIni::Canonicalize( const FStringView Contents, FString& OutCanonical, const FConfigSyncKeyFilter* KeyFilter )
+{
+	TRACE_CPU_SCOPE;
+
+	using FKeyLines = TMap< FString, TArray< FString > >;
+
+	TMap< FString, FKeyLines > Sections;
+
+	auto VisitLine = [&]( const FConfigSyncIniLine& Line )
+	{
+		if( Line.Token != EConfigSyncIniToken::Entry || Line.Section.IsEmpty() )
+			return;
+
+		if( KeyFilter && KeyFilter->IsExcluded( Line.Section, Line.Key ) )
+			return;
+
+		FKeyLines& KeyLines = Sections.FindOrAdd( FString( Line.Section ).ToLower() );
+		KeyLines.FindOrAdd( FString( GetBaseKeyName( Line.Key ) ).ToLower() ).Add( FString( Line.Key ).ToLower() + TEXT( "=" ) + FString( Line.Value ) );
+	};
+
+	Stream( Contents, VisitLine );
+
+	Sections.KeySort( TLess< FString >() );
+
+	OutCanonical.Reset( Contents.Len() );
+	for( TPair< FString, FKeyLines >& Section: Sections )
+	{
+		OutCanonical.Appendf( TEXT( "[%s]\n" ), *Section.Key );
+
+		Section.Value.KeySort( TLess< FString >() );
+		for( const TPair< FString, TArray< FString > >& KeyLines: Section.Value )
+		{
+			for( const FString& KeyLine: KeyLines.Value )
+			{
+				OutCanonical.Append( KeyLine );
+				OutCanonical.AppendChar( TEXT( '\n' ) );
+			}
+		}
+	}
+}
+
+uint64 FConfigSyncIni::CanonicalHash( const FStringView Contents, const FConfigSyncKeyFilter* KeyFilter )
+{
+	TRACE_CPU_SCOPE;
+
+	FString Canonical;
+	Canonicalize( Contents, Canonical, KeyFilter );
+	return CityHash64( reinterpret_cast< const char* >( *Canonical ), Canonical.Len() * sizeof( TCHAR ) );
+}
+
+void FConfigSyncIni::Diff( const TArray< FConfigSyncIniSection >& OldSections, const TArray< FConfigSyncIniSection >& NewSections, TMap< FString, TSet< FString > >& OutChangedKeys )
+{
+	TRACE_CPU_SCOPE;
+
+	using FKeyValues = TMap< FString, TArray< FString > >;
+
+	auto GatherSections = []( const TArray< FConfigSyncIniSection >& Sections )
+	{
+		TMap< FString, FKeyValues > Result;
+		for( const FConfigSyncIniSection& Section: Sections )
+		{
+			FKeyValues& KeyValues = Result.Add( Section.Name );
+			for( const FConfigSyncIniEntry& Entry: Section.Entries )
+				KeyValues.FindOrAdd( FString( GetBaseKeyName( Entry.Key ) ) ).Add( Entry.Key + TEXT( "=" ) + Entry.Value );
+		}
+		return Result;
+	};
+
+	const TMap< FString, FKeyValues > OldKeyValues = GatherSections( OldSections );
+	const TMap< FString, FKeyValues > NewKeyValues = GatherSections( NewSections );
+
+	// Values are compared case-sensitively; FString's operator== ignores case and would drop edits such as "my game" -> "My Game".
+	auto AreValuesEqual = []( const TArray< FString >& Lhs, const TArray< FString >& Rhs )
+	{
+		if( Lhs.Num() != Rhs.Num() )
+			return false;
+
+		for( int32 i = 0; i < Lhs.Num(); ++i )
+		{
+			if( !Lhs[ i ].Equals( Rhs[ i ], ESearchCase::CaseSensitive ) )
+				return false;
+		}
+
+		return true;
+	};
+
+	auto CompareSection = [&OutChangedKeys, &AreValuesEqual]( const FString& SectionName, const FKeyValues& Lhs, const FKeyValues* Rhs )
+	{
+		for( const TPair< FString, TArray< FString > >& KeyValue: Lhs )
+		{
+			const TArray< FString >* OtherValues = Rhs ? Rhs->Find( KeyValue.Key ) : nullptr;
+			if( !OtherValues || !AreValuesEqual( *OtherValues, KeyValue.Value ) )
+				OutChangedKeys.FindOrAdd( SectionName ).Add( KeyValue.Key );
+		}
+	};
+
+	for( const TPair< FString, FKeyValues >& Section: NewKeyValues )
+		CompareSection( Section.Key, Section.Value, OldKeyValues.Find( Section.Key ) );
+
+	for( const TPair< FString, FKeyValues >& Section: OldKeyValues )
+		CompareSection( Section.Key, Section.Value, NewKeyValues.Find( Section.Key ) );
+}
+
+void FConfigSyncIni::MakeChanges( const TArray< FConfigSyncIniSection >& OldSections, const TArray< FConfigSyncIniSection >& NewSections, TArray< FConfigSyncIniChange >& OutChanges )
+{
+	TRACE_CPU_SCOPE;
+
+	TMap< FString, TSet< FString > > ChangedKeys;
+	Diff( OldSections, NewSections, ChangedKeys );
+
+	TMap< FString, const FConfigSyncIniSection* > NewSectionsByName;
+	for( const FConfigSyncIniSection& Section: NewSections )
+		NewSectionsByName.Add( Section.Name, &Section );
+
+	for( const TPair< FString, TSet< FString > >& Section: ChangedKeys )
+	{
+		const FConfigSyncIniSection* const* NewSection = NewSectionsByName.Find( Section.Key );
+		for( const FString& Key: Section.Value )
+		{
+			FConfigSyncIniChange& Change = OutChanges.AddDefaulted_GetRef();
+			Change.Section               = Section.Key;
+			Change.Key                   = Key;
+
+			if( !NewSection )
+				continue;
+
+			for( const FConfigSyncIniEntry& Entry: ( *NewSection )->Entries )
+			{
+				if( GetBaseKeyName( Entry.Key ).Equals( Key, ESearchCase::IgnoreCase ) )
+					Change.Lines.Add( Entry.Key + TEXT( "=" ) + Entry.Value );
+			}
+		}
+	}
+}
+
+void FConfigSyncIni::ApplyChanges( const FStringView Contents, const TArray< FConfigSyncIniChange >& Changes, FString& OutContents )
+{
+	TRACE_CPU_SCOPE;
+
+	// Streaming normalizes line endings and the trailing newline, which would make a pull without deltas rewrite the file anyway.
+	if( Changes.IsEmpty() )
+	{
+		OutContents = FString( Contents );
+		return;
+	}
+
+	TMap< FString, TMap< FString, const FConfigSyncIniChange* > > ChangesBySection;
+	for( const FConfigSyncIniChange& Change: Changes )
+		ChangesBySection.FindOrAdd( Change.Section ).Add( Change.Key, &Change );
+
+	OutContents.Reset( Contents.Len() );
+
+	TMap< FString, TSet< FString > > AppliedKeys;
+	FString                          CurrentSection;
+	int32                            PendingBlankLines = 0;
+
+	auto AppendLine = [&OutContents]( const FStringView Line )
+	{
+		OutContents.Append( Line );
+		OutContents.Append( LINE_TERMINATOR );
+	};
+
+	auto AppendPendingBlankLines = [&]
+	{
+		for( ; PendingBlankLines > 0; --PendingBlankLines )
+			AppendLine( FStringView() );
+	};
+
+	auto AppendChange = [&]( const FConfigSyncIniChange& Change )
+	{
+		bool bAlreadyApplied = false;
+		AppliedKeys.FindOrAdd( Change.Section ).Add( Change.Key, &bAlreadyApplied );
+		if( bAlreadyApplied )
+			return;
+
+		for( const FString& Line: Change.Lines )
+			AppendLine( Line );
+	};
+
+	auto FlushSection = [&]( const FString& Section )
+	{
+		if( const TMap< FString, const FConfigSyncIniChange* >* SectionChanges = ChangesBySection.Find( Section ) )
+		{
+			for( const TPair< FString, const FConfigSyncIniChange* >& Change: *SectionChanges )
+				AppendChange( *Change.Value );
+		}
+	};
+
+	auto VisitLine = [&]( const FConfigSyncIniLine& Line )
+	{
+		switch( Line.Token )
+		{
+			case EConfigSyncIniToken::Blank:
+				PendingBlankLines++;
+				return;
+			case EConfigSyncIniToken::Section:
+				FlushSection( CurrentSection );
+				CurrentSection = FString( Line.Section );
+				break;
+			case EConfigSyncIniToken::Entry:
+				if( const TMap< FString, const FConfigSyncIniChange* >* SectionChanges = ChangesBySection.Find( CurrentSection ) )
+				{
+					if( const FConfigSyncIniChange* const* Change = SectionChanges->Find( FString( GetBaseKeyName( Line.Key ) ) ) )
+					{
+						AppendPendingBlankLines();
+						AppendChange( **Change );
+						return;
+					}
+				}
+				break;
+			default:
+				break;
+		}
+
+		AppendPendingBlankLines();
+		AppendLine( Line.Line );
+	};
+
+	Stream( Contents, VisitLine );
+	FlushSection( CurrentSection );
+
+	for( const TPair< FString, TMap< FString, const FConfigSyncIniChange* > >& Section: ChangesBySection )
+	{
+		bool bHasLines = false;
+		for( const TPair< FString, const FConfigSyncIniChange* >& Change: Section.Value )
+			bHasLines |= !AppliedKeys.FindOrAdd( Section.Key ).Contains( Change.Key ) && !Change.Value->Lines.IsEmpty();
+
+		if( !bHasLines )
+			continue;
+
+		if( !OutContents.IsEmpty() )
+			AppendLine( FStringView() );
+
+		AppendLine( FString::Printf( TEXT( "[%s]" ), *Section.Key ) );
+		FlushSection( Section.Key );
+	}
+
+	AppendPendingBlankLines();
+}
+
+FStringView FConfigSyncIni::GetBaseKeyName( const FStringView Key )
+{
+	if( !Key.IsEmpty() && FCString::Strchr( TEXT( "+-!.@*" ), Key[ 0 ] ) )
+		return Key.RightChop( 1 );
+
+	return Key;
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "FConfigSyncKeyFilter.h"
+
+#include "FConfigSyncIni.h"
+#include "Macros.h"
+#include "String/Find.h"
+#include "UConfigSyncSettings.h"
+
+FConfigSyncKeyFilter::FConfigSyncKeyFilter( const TArray< FConfigSyncKeyRule >& Rules, const FString& RelativePath )
+{
+	TRACE_CPU_SCOPE;
+
+	const FString NormalizedPath = RelativePath.Replace( TEXT( "\\" ), TEXT( "/" ) );
+	const FString FileName       = FPaths::GetCleanFilename( NormalizedPath );
+
+	for( const FConfigSyncKeyRule& Rule: Rules )
+	{
+		if( Rule.Key.IsEmpty() )
+			continue;
+
+		const FPattern FilePattern = FPattern::Compile( Rule.File );
+		if( !FilePattern.Matches( FileName ) && !FilePattern.Matches( NormalizedPath ) )
+			continue;
+
+		FCompiledRule& CompiledRule = CompiledRules.AddDefaulted_GetRef();
+		CompiledRule.Section        = FPattern::Compile( Rule.Section );
+		CompiledRule.Key            = FPattern::Compile( Rule.Key );
+		CompiledRule.bExclude       = Rule.bExclude;
+
+		bHasExcludeRules |= Rule.bExclude;
+	}
+}
+
+bool FConfigSyncKeyFilter::IsExcluded( const FStringView Section, const FStringView Key ) const
+{
+	if( Section.IsEmpty() )
+		return false;
+
+	const FStringView BaseKey = FConfigSyncIni::GetBaseKeyName( Key );
+	for( int32 i = CompiledRules.Num() - 1; i >= 0; --i )
+	{
+		const FCompiledRule& Rule = CompiledRules[ i ];
+		if( Rule.Section.Matches( Section ) && Rule.Key.Matches( BaseKey ) )
+			return Rule.bExclude;
+	}
+
+	return false;
+}
+
+void FConfigSyncKeyFilter::Apply( const FString& Source, const FString& Destination, FString& OutContents ) const
+{
+	TRACE_CPU_SCOPE;
+
+	TMap< FString, TArray< FStringView > > RetainedLines;
+
+	auto RetainLine = [&]( const FConfigSyncIniLine& Line )
+	{
+		if( Line.Token == EConfigSyncIniToken::Entry && IsExcluded( Line.Section, Line.Key ) )
+			RetainedLines.FindOrAdd( FString( Line.Section ) ).Add( Line.Line );
+	};
+
+	FConfigSyncIni::Stream( Destination, RetainLine );
+
+	OutContents.Reset( Source.Len() );
+
+	TSet< FString > FlushedSections;
+	FString         CurrentSection;
+	int32           PendingBlankLines = 0;
+
+	auto AppendLine = [&OutContents]( const FStringView Line )
+	{
+		OutContents.Append( Line );
+		OutContents.Append( LINE_TERMINATOR );
+	};
+
+	auto FlushRetained = [&]( const FString& Section )
+	{
+		const TArray< FStringView >* Lines = RetainedLines.Find( Section );
+		if( !Lines || FlushedSections.Contains( Section ) )
+			return;
+
+		for( const FStringView Line: *Lines )
+			AppendLine( Line );
+
+		FlushedSections.Add( Section );
+	};
+
+	auto VisitLine = [&]( const FConfigSyncIniLine& Line )
+	{
+		switch( Line.Token )
+		{
+			case EConfigSyncIniToken::Blank:
+				PendingBlankLines++;
+				return;
+			case EConfigSyncIniToken::Section:
+				FlushRetained( CurrentSection );
+				CurrentSection = FString( Line.Section );
+				break;
+			case EConfigSyncIniToken::Entry:
+				if( IsExcluded( Line.Section, Line.Key ) )
+					return;
+				break;
+			default:
+				break;
+		}
+
+		for( ; PendingBlankLines > 0; --PendingBlankLines )
+			AppendLine( FStringView() );
+
+		AppendLine( Line.Line );
+	};
+
+	FConfigSyncIni::Stream( Source, VisitLine );
+	FlushRetained( CurrentSection );
+
+	for( const TPair< FString, TArray< FStringView > >& Section: RetainedLines )
+	{
+		if( FlushedSections.Contains( Section.Key ) )
+			continue;
+
+		if( !OutContents.IsEmpty() )
+			AppendLine( FStringView() );
+
+		AppendLine( FString::Printf( TEXT( "[%s]" ), *Section.Key ) );
+		for( const FStringView Line: Section.Value )
+			AppendLine( Line );
+	}
+}
+
+FConfigSyncKeyFilter::FPattern FConfigSyncKeyFilter::FPattern::Compile( const FString& Pattern )
+{
+	FPattern Result;
+	if( Pattern.IsEmpty() || Pattern == TEXT( "*" ) )
+		return Result;
+
+	const bool    bLeadingWildcard  = Pattern.StartsWith( TEXT( "*" ) );
+	const bool    bTrailingWildcard = Pattern.Len() > 1 && Pattern.EndsWith( TEXT( "*" ) );
+	const FString Inner             = Pattern.Mid( bLeadingWildcard ? 1 : 0, Pattern.Len() - bLeadingWildcard - bTrailingWildcard );
+
+	int32 WildcardIndex = INDEX_NONE;
+	if( Inner.FindChar( TEXT( '*' ), WildcardIndex ) || Inner.FindChar( TEXT( '?' ), WildcardIndex ) )
+	{
+		Result.Kind = EKind::Wildcard;
+		Result.Text = Pattern;
+		return Result;
+	}
+
+	Result.Text = Inner;
+	if( bLeadingWildcard && bTrailingWildcard )
+		Result.Kind = EKind::Contains;
+	else if( bLeadingWildcard )
+		Result.Kind = EKind::Suffix;
+	else if( bTrailingWildcard )
+		Result.Kind = EKind::Prefix;
+	else
+		Result.Kind = EKind::Exact;
+
+	return Result;
+}
+
+bool FConfigSyncKeyFilter::FPattern::Matches( const FStringView Value ) const
+{
+	switch( Kind )
+	{
+		case EKind::Any:
+			return true;
+		case EKind::Exact:
+			return Value.Equals( Text, ESearchCase::IgnoreCase );
+		case EKind::Prefix:
+			return Value.StartsWith( Text, ESearchCase::IgnoreCase );
+		case EKind::Suffix:
+			return Value.EndsWith( Text, ESearchCase::IgnoreCase );
+		case EKind::Contains:
+			return UE::String::FindFirst( Value, Text, ESearchCase::IgnoreCase ) != INDEX_NONE;
+		case EKind::Wildcard:
+			return FString( Value ).MatchesWildcard( Text );
+		default:
+			return false;
+	}
+}
\ No newline at end of file
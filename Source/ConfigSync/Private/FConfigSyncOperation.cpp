@@ -0,0 +1,80 @@
+#include "FConfigSyncOperation.h"
+
+#include "Async/Async.h"
+#include "Macros.h"
+
+#define LOCTEXT_NAMESPACE "ConfigSyncOperation"
+
+FConfigSyncOperation::FConfigSyncOperation( const FText& InDescription, const int32 InFilesTotal )
+	: Description( InDescription )
+	, FilesTotal( InFilesTotal )
+{}
+
+TSharedRef< FConfigSyncOperation > FConfigSyncOperation::Launch( const FText& Description, const int32 FilesTotal, FWork Work, FOnCompleted OnCompleted )
+{
+	TRACE_CPU_SCOPE;
+
+	TSharedRef< FConfigSyncOperation > Operation = MakeShared< FConfigSyncOperation >( Description, FilesTotal );
+
+	Operation->WorkFuture = Async( EAsyncExecution::ThreadPool, [Operation, Work = MoveTemp( Work )]
+	{
+		Work( *Operation );
+	} );
+
+	// Polled from the ticker rather than queued as a game thread task, so CancelAndWait can remove it before it runs.
+	Operation->CompletionHandle = FTSTicker::GetCoreTicker().AddTicker( FTickerDelegate::CreateLambda( [Operation, OnCompleted = MoveTemp( OnCompleted )]( float )
+	{
+		if( !Operation->WorkFuture.IsReady() )
+			return true;
+
+		Operation->bRunning = false;
+		OnCompleted( Operation->IsCancelled() );
+		return false;
+	} ) );
+
+	return Operation;
+}
+
+void FConfigSyncOperation::CancelAndWait()
+{
+	TRACE_CPU_SCOPE;
+
+	Cancel();
+	if( WorkFuture.IsValid() )
+		WorkFuture.Wait();
+
+	FTSTicker::GetCoreTicker().RemoveTicker( CompletionHandle );
+	bRunning = false;
+}
+
+void FConfigSyncOperation::AddProgress( const int32 Files, const int64 Bytes )
+{
+	FilesDone += Files;
+	BytesDone += Bytes;
+}
+
+TOptional< float > FConfigSyncOperation::GetProgressFraction() const
+{
+	const int32 Total = FilesTotal;
+	if( Total <= 0 )
+		return TOptional< float >();
+
+	return static_cast< float >( FilesDone ) / Total;
+}
+
+FText FConfigSyncOperation::GetProgressText() const
+{
+	if( bCancelRequested )
+		return FText::Format( LOCTEXT( "Cancelling", "{0}: cancelling..." ), Description );
+
+	if( FilesTotal <= 0 )
+		return FText::Format( LOCTEXT( "ProgressUnbounded", "{0}: {1} files" ), Description, FText::AsNumber( FilesDone.load() ) );
+
+	return FText::Format( LOCTEXT( "Progress", "{0}: {1} / {2} files ({3})" ),
+	                      Description,
+	                      FText::AsNumber( FilesDone.load() ),
+	                      FText::AsNumber( FilesTotal.load() ),
+	                      FText::AsMemory( BytesDone.load() ) );
+}
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
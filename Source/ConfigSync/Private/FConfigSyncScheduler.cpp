@@ -0,0 +1,66 @@
+#include "FConfigSyncScheduler.h"
+
+#include "Macros.h"
+
+void FConfigSyncScheduler::SetIntervals( const double InMinInterval, const double InMaxInterval )
+{
+	TRACE_CPU_SCOPE;
+
+	MinInterval = FMath::Max( InMinInterval, 0.1 );
+	MaxInterval = FMath::Max( InMaxInterval, MinInterval );
+
+	for( TPair< FString, double >& Interval: Intervals )
+		Interval.Value = FMath::Clamp( Interval.Value, MinInterval, MaxInterval );
+}
+
+void FConfigSyncScheduler::Add( const FString& FileId, const double Now, const double InitialInterval )
+{
+	TRACE_CPU_SCOPE;
+
+	if( Intervals.Contains( FileId ) )
+		return;
+
+	Intervals.Add( FileId, FMath::Clamp( InitialInterval, MinInterval, MaxInterval ) );
+	Queue.HeapPush( { Now, FileId } );
+}
+
+void FConfigSyncScheduler::Retain( const TSet< FString >& FileIds )
+{
+	TRACE_CPU_SCOPE;
+
+	for( auto It = Intervals.CreateIterator(); It; ++It )
+	{
+		if( !FileIds.Contains( It.Key() ) )
+			It.RemoveCurrent();
+	}
+
+	const int32 QueueNum = Queue.Num();
+	Queue.RemoveAll( [&FileIds]( const FScheduledFile& ScheduledFile ) { return !FileIds.Contains( ScheduledFile.FileId ); } );
+	if( Queue.Num() != QueueNum )
+		Queue.Heapify();
+}
+
+void FConfigSyncScheduler::PopDue( const double Now, const int32 Budget, TArray< FString >& OutDueFiles )
+{
+	TRACE_CPU_SCOPE;
+
+	OutDueFiles.Reset();
+	while( !Queue.IsEmpty() && OutDueFiles.Num() < Budget && Queue.HeapTop().NextCheckTime <= Now )
+	{
+		FScheduledFile ScheduledFile;
+		Queue.HeapPop( ScheduledFile, EAllowShrinking::No );
+		OutDueFiles.Add( MoveTemp( ScheduledFile.FileId ) );
+	}
+}
+
+void FConfigSyncScheduler::Reschedule( const FString& FileId, const double Now, const bool bChanged )
+{
+	TRACE_CPU_SCOPE;
+
+	double* Interval = Intervals.Find( FileId );
+	if( !Interval )
+		return;
+
+	*Interval = bChanged ? MinInterval : FMath::Min( *Interval * 2, MaxInterval );
+	Queue.HeapPush( { Now + *Interval, FileId } );
+}
\ No newline at end of file
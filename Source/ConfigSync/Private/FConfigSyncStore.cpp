@@ -0,0 +1,456 @@
+#include "FConfigSyncStore.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "FConfigSync.h"
+#include "Macros.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "String/ParseLines.h"
+
+bool FConfigSyncStore::Read( const FString& StorePath, FString& OutContents, FConfigSyncStoreHead* OutHead )
+{
+	TRACE_CPU_SCOPE;
+
+	const FScopedLock Lock;
+	if( !Lock.IsLocked() )
+		return false;
+
+	FConfigSyncStoreHead Head;
+	if( !ReadFile( ResolvePath( StorePath ), OutContents, Head ) )
+		return false;
+
+	if( OutHead )
+		*OutHead = MoveTemp( Head );
+
+	return true;
+}
+
+bool FConfigSyncStore::Write( const FString& StorePath, const FString& NewContents )
+{
+	TRACE_CPU_SCOPE;
+
+	const FScopedLock Lock;
+	if( !Lock.IsLocked() )
+		return false;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString  DeltaLogPath = GetDeltaLogPath( StorePath );
+
+	FString              Base;
+	FConfigSyncStoreHead BaseHead;
+	TArray< FDelta >     Deltas;
+
+	const bool bInherited = !FFileHelper::LoadFileToString( Base, *StorePath );
+	if( bInherited )
+	{
+		const FString InheritedPath = ResolvePath( StorePath );
+		if( InheritedPath == StorePath || !ReadFile( InheritedPath, Base, BaseHead ) )
+			return CreateBase( StorePath, NewContents );
+	}
+	else
+		LoadDeltas( StorePath, BaseHead, Deltas );
+
+	FString CurrentContents;
+	Materialize( Base, Deltas, CurrentContents );
+
+	TArray< FConfigSyncIniSection > CurrentSections;
+	TArray< FConfigSyncIniSection > NewSections;
+	FConfigSyncIni::Parse( CurrentContents, CurrentSections );
+	FConfigSyncIni::Parse( NewContents, NewSections );
+
+	FDelta Delta;
+	Delta.Sequence = GetHead( BaseHead, Deltas ).Sequence + 1;
+	FConfigSyncIni::MakeChanges( CurrentSections, NewSections, Delta.Changes );
+	if( Delta.Changes.IsEmpty() )
+		return true;
+
+	// The inherited file only gets a local copy once it diverges. The copy continues the parent's generation and head so pulls made from the parent stay incremental.
+	if( bInherited )
+	{
+		FDelta BaseMarker;
+		BaseMarker.Sequence   = BaseHead.Sequence;
+		BaseMarker.Generation = BaseHead.Generation;
+
+		if( !PlatformFile.CreateDirectoryTree( *FPaths::GetPath( StorePath ) ) || !FFileHelper::SaveStringToFile( Base, *StorePath )
+			|| !FFileHelper::SaveStringToFile( SerializeDelta( BaseMarker ) + LINE_TERMINATOR, *DeltaLogPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM ) )
+		{
+			UE_LOG( LogConfigSync, Error, TEXT( "Failed to copy inherited file: %s" ), *StorePath );
+			return false;
+		}
+	}
+
+	if( !FFileHelper::SaveStringToFile( SerializeDelta( Delta ) + LINE_TERMINATOR, *DeltaLogPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append ) )
+	{
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to append delta: %s" ), *DeltaLogPath );
+		return false;
+	}
+
+	if( Deltas.Num() + 1 > CompactionThreshold )
+		ScheduleCompaction( StorePath );
+
+	return true;
+}
+
+bool FConfigSyncStore::ReadChangesSince( const FString& StorePath, const FConfigSyncStoreHead& Since, TArray< FConfigSyncIniChange >& OutChanges, FConfigSyncStoreHead& OutHead )
+{
+	TRACE_CPU_SCOPE;
+
+	const FScopedLock Lock;
+	if( !Lock.IsLocked() )
+		return false;
+
+	const FString ReadPath = ResolvePath( StorePath );
+	if( Since.Sequence < 0 || !FPlatformFileManager::Get().GetPlatformFile().FileExists( *ReadPath ) )
+		return false;
+
+	FConfigSyncStoreHead BaseHead;
+	TArray< FDelta >     Deltas;
+	LoadDeltas( ReadPath, BaseHead, Deltas );
+
+	// Another generation means the file was deleted and recreated since it was pulled, so its numbering says nothing about the caller's contents.
+	const FConfigSyncStoreHead Head = GetHead( BaseHead, Deltas );
+	if( !Since.Generation.Equals( Head.Generation, ESearchCase::CaseSensitive ) || Since.Sequence < BaseHead.Sequence || Since.Sequence > Head.Sequence )
+		return false;
+
+	for( const FDelta& Delta: Deltas )
+	{
+		if( Delta.Sequence > Since.Sequence )
+			OutChanges.Append( Delta.Changes );
+	}
+
+	OutHead = Head;
+	return true;
+}
+
+void FConfigSyncStore::Compact( const FString& StorePath )
+{
+	TRACE_CPU_SCOPE;
+
+	FString              Base;
+	FConfigSyncStoreHead BaseHead;
+	TArray< FDelta >     Deltas;
+	{
+		const FScopedLock Lock;
+		if( !Lock.IsLocked() || !FFileHelper::LoadFileToString( Base, *StorePath ) )
+			return;
+
+		LoadDeltas( StorePath, BaseHead, Deltas );
+	}
+
+	if( Deltas.IsEmpty() )
+		return;
+
+	// Materializing is the expensive part, so it runs unlocked and only the swap below blocks other readers and writers.
+	FString Compacted;
+	Materialize( Base, Deltas, Compacted );
+
+	const int64 CompactedSequence = Deltas.Last().Sequence;
+
+	const FScopedLock Lock;
+	if( !Lock.IsLocked() )
+		return;
+
+	// Other threads or editors may have appended, compacted or recreated the file since the snapshot. Records newer than the snapshot are carried over, and the
+	// swap is abandoned when the log no longer continues from it.
+	FConfigSyncStoreHead CurrentBaseHead;
+	TArray< FDelta >     CurrentDeltas;
+	LoadDeltas( StorePath, CurrentBaseHead, CurrentDeltas );
+	if( !CurrentBaseHead.Generation.Equals( BaseHead.Generation, ESearchCase::CaseSensitive ) || CurrentBaseHead.Sequence != BaseHead.Sequence
+		|| CurrentDeltas.Num() < Deltas.Num() || CurrentDeltas[ Deltas.Num() - 1 ].Sequence != CompactedSequence )
+		return;
+
+	if( !FFileHelper::SaveStringToFile( Compacted, *StorePath ) )
+	{
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to write compacted file: %s" ), *StorePath );
+		return;
+	}
+
+	FDelta BaseMarker;
+	BaseMarker.Sequence   = CompactedSequence;
+	BaseMarker.Generation = BaseHead.Generation;
+
+	FString DeltaLog = SerializeDelta( BaseMarker ) + LINE_TERMINATOR;
+	for( int32 i = Deltas.Num(); i < CurrentDeltas.Num(); ++i )
+		DeltaLog += SerializeDelta( CurrentDeltas[ i ] ) + LINE_TERMINATOR;
+
+	const FString DeltaLogPath = GetDeltaLogPath( StorePath );
+	if( !FFileHelper::SaveStringToFile( DeltaLog, *DeltaLogPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM ) )
+	{
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to reset delta log: %s" ), *DeltaLogPath );
+		return;
+	}
+
+	UE_LOG( LogConfigSync, Log, TEXT( "Compacted %d deltas into: %s" ), Deltas.Num(), *StorePath );
+}
+
+bool FConfigSyncStore::CreateBase( const FString& StorePath, const FString& Contents )
+{
+	TRACE_CPU_SCOPE;
+
+	FDelta BaseMarker;
+	BaseMarker.Sequence   = 0;
+	BaseMarker.Generation = FGuid::NewGuid().ToString();
+
+	// The log is replaced first, so a stale log from a deleted predecessor is never replayed onto the new base.
+	if( !FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree( *FPaths::GetPath( StorePath ) )
+		|| !FFileHelper::SaveStringToFile( SerializeDelta( BaseMarker ) + LINE_TERMINATOR, *GetDeltaLogPath( StorePath ), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM ) )
+		return false;
+
+	return FFileHelper::SaveStringToFile( Contents, *StorePath );
+}
+
+void FConfigSyncStore::ScheduleCompaction( const FString& StorePath )
+{
+	TRACE_CPU_SCOPE;
+
+	FScopeLock Lock( &StoreLock );
+
+	// Every write past the threshold asks again, so a compaction that is still queued or running covers them all.
+	const TFuture< void >* Compaction = Compactions.Find( StorePath );
+	if( Compaction && !Compaction->IsReady() )
+		return;
+
+	Compactions.Add( StorePath, Async( EAsyncExecution::ThreadPool, [StorePath] { Compact( StorePath ); } ) );
+}
+
+void FConfigSyncStore::WaitForCompactions()
+{
+	TRACE_CPU_SCOPE;
+
+	TMap< FString, TFuture< void > > PendingCompactions;
+	{
+		FScopeLock Lock( &StoreLock );
+		PendingCompactions = MoveTemp( Compactions );
+	}
+
+	for( TPair< FString, TFuture< void > >& Compaction: PendingCompactions )
+		Compaction.Value.Wait();
+}
+
+void FConfigSyncStore::SetLockFilePath( const FString& InLockFilePath )
+{
+	TRACE_CPU_SCOPE;
+
+	FScopeLock Lock( &StoreLock );
+
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree( *FPaths::GetPath( InLockFilePath ) );
+	LockFilePath = InLockFilePath;
+}
+
+void FConfigSyncStore::SetParentDirectory( const FString& Directory, const FString& ParentDirectory )
+{
+	TRACE_CPU_SCOPE;
+
+	FScopeLock Lock( &StoreLock );
+	ParentDirectories.Add( Directory, ParentDirectory );
+}
+
+FConfigSyncStore::FScopedLock::FScopedLock()
+	: ThreadLock( &StoreLock )
+{
+	TRACE_CPU_SCOPE;
+
+	if( LockFilePath.IsEmpty() )
+	{
+		bLocked = true;
+		return;
+	}
+
+	// Opening for write without shared access fails while another editor holds the file, so this polls until that editor releases it.
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const double   Deadline     = FPlatformTime::Seconds() + LockTimeout;
+	do
+	{
+		FileHandle.Reset( PlatformFile.OpenWrite( *LockFilePath ) );
+		if( FileHandle.IsValid() )
+		{
+			bLocked = true;
+			return;
+		}
+
+		FPlatformProcess::Sleep( 0.005f );
+	}
+	while( FPlatformTime::Seconds() < Deadline );
+
+	UE_LOG( LogConfigSync, Error, TEXT( "Timed out waiting for store lock: %s" ), *LockFilePath );
+}
+
+FConfigSyncStore::FScopedLock::~FScopedLock() = default;
+
+FString FConfigSyncStore::ResolvePath( const FString& StorePath )
+{
+	TRACE_CPU_SCOPE;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// Bounded by the number of links so a misconfigured cycle cannot loop forever.
+	FString Path = StorePath;
+	for( int32 Depth = 0; Depth <= ParentDirectories.Num(); ++Depth )
+	{
+		if( PlatformFile.FileExists( *Path ) )
+			return Path;
+
+		bool bHasParent = false;
+		for( const TPair< FString, FString >& Link: ParentDirectories )
+		{
+			if( Path.StartsWith( Link.Key + TEXT( "/" ) ) )
+			{
+				Path       = FPaths::Combine( Link.Value, Path.RightChop( Link.Key.Len() + 1 ) );
+				bHasParent = true;
+				break;
+			}
+		}
+
+		if( !bHasParent )
+			break;
+	}
+
+	return StorePath;
+}
+
+bool FConfigSyncStore::ReadFile( const FString& Path, FString& OutContents, FConfigSyncStoreHead& OutHead )
+{
+	TRACE_CPU_SCOPE;
+
+	FString Base;
+	if( !FFileHelper::LoadFileToString( Base, *Path ) )
+		return false;
+
+	FConfigSyncStoreHead BaseHead;
+	TArray< FDelta >     Deltas;
+	LoadDeltas( Path, BaseHead, Deltas );
+	Materialize( Base, Deltas, OutContents );
+
+	OutHead = GetHead( BaseHead, Deltas );
+	return true;
+}
+
+void FConfigSyncStore::LoadDeltas( const FString& StorePath, FConfigSyncStoreHead& OutBase, TArray< FDelta >& OutDeltas )
+{
+	TRACE_CPU_SCOPE;
+
+	OutBase.Generation.Reset();
+	OutBase.Sequence = 0;
+	OutDeltas.Reset();
+
+	FString DeltaLog;
+	if( !FFileHelper::LoadFileToString( DeltaLog, *GetDeltaLogPath( StorePath ) ) )
+		return;
+
+	bool bFirstRecord = true;
+
+	auto VisitLine = [&]( const FStringView Line )
+	{
+		FDelta Delta;
+		if( !DeserializeDelta( FString( Line ), Delta ) )
+			return;
+
+		if( bFirstRecord && Delta.Changes.IsEmpty() )
+		{
+			OutBase.Sequence   = Delta.Sequence;
+			OutBase.Generation = MoveTemp( Delta.Generation );
+		}
+		else if( !Delta.Changes.IsEmpty() )
+			OutDeltas.Add( MoveTemp( Delta ) );
+
+		bFirstRecord = false;
+	};
+
+	UE::String::ParseLines( DeltaLog, VisitLine );
+}
+
+FConfigSyncStoreHead FConfigSyncStore::GetHead( const FConfigSyncStoreHead& Base, const TArray< FDelta >& Deltas )
+{
+	TRACE_CPU_SCOPE;
+
+	FConfigSyncStoreHead Head;
+	Head.Generation = Base.Generation;
+	Head.Sequence   = Deltas.IsEmpty() ? Base.Sequence : Deltas.Last().Sequence;
+	return Head;
+}
+
+void FConfigSyncStore::Materialize( const FString& Base, const TArray< FDelta >& Deltas, FString& OutContents )
+{
+	TRACE_CPU_SCOPE;
+
+	if( Deltas.IsEmpty() )
+	{
+		OutContents = Base;
+		return;
+	}
+
+	TArray< FConfigSyncIniChange > Changes;
+	for( const FDelta& Delta: Deltas )
+		Changes.Append( Delta.Changes );
+
+	FConfigSyncIni::ApplyChanges( Base, Changes, OutContents );
+}
+
+FString FConfigSyncStore::SerializeDelta( const FDelta& Delta )
+{
+	TRACE_CPU_SCOPE;
+
+	TArray< TSharedPtr< FJsonValue > > ChangeValues;
+	for( const FConfigSyncIniChange& Change: Delta.Changes )
+	{
+		TArray< TSharedPtr< FJsonValue > > LineValues;
+		for( const FString& Line: Change.Lines )
+			LineValues.Add( MakeShared< FJsonValueString >( Line ) );
+
+		const TSharedRef< FJsonObject > ChangeObject = MakeShared< FJsonObject >();
+		ChangeObject->SetStringField( TEXT( "Section" ), Change.Section );
+		ChangeObject->SetStringField( TEXT( "Key" ), Change.Key );
+		ChangeObject->SetArrayField( TEXT( "Lines" ), LineValues );
+		ChangeValues.Add( MakeShared< FJsonValueObject >( ChangeObject ) );
+	}
+
+	const TSharedRef< FJsonObject > DeltaObject = MakeShared< FJsonObject >();
+	DeltaObject->SetNumberField( TEXT( "Sequence" ), Delta.Sequence );
+	if( !Delta.Generation.IsEmpty() )
+		DeltaObject->SetStringField( TEXT( "Generation" ), Delta.Generation );
+	DeltaObject->SetArrayField( TEXT( "Changes" ), ChangeValues );
+
+	FString OutputString;
+
+	const TSharedRef< TJsonWriter< TCHAR, TCondensedJsonPrintPolicy< TCHAR > > > Writer = TJsonWriterFactory< TCHAR, TCondensedJsonPrintPolicy< TCHAR > >::Create( &OutputString );
+	FJsonSerializer::Serialize( DeltaObject, Writer );
+	return OutputString;
+}
+
+bool FConfigSyncStore::DeserializeDelta( const FString& Line, FDelta& OutDelta )
+{
+	TRACE_CPU_SCOPE;
+
+	TSharedPtr< FJsonObject > DeltaObject;
+	if( !FJsonSerializer::Deserialize( TJsonReaderFactory<>::Create( Line ), DeltaObject ) || !DeltaObject.IsValid() )
+		return false;
+
+	if( !DeltaObject->TryGetNumberField( TEXT( "Sequence" ), OutDelta.Sequence ) )
+		return false;
+
+	DeltaObject->TryGetStringField( TEXT( "Generation" ), OutDelta.Generation );
+
+	const TArray< TSharedPtr< FJsonValue > >* ChangeValues = nullptr;
+	if( !DeltaObject->TryGetArrayField( TEXT( "Changes" ), ChangeValues ) )
+		return true;
+
+	for( const TSharedPtr< FJsonValue >& ChangeValue: *ChangeValues )
+	{
+		const TSharedPtr< FJsonObject >* ChangeObject = nullptr;
+		if( !ChangeValue->TryGetObject( ChangeObject ) )
+			continue;
+
+		FConfigSyncIniChange& Change = OutDelta.Changes.AddDefaulted_GetRef();
+		( *ChangeObject )->TryGetStringField( TEXT( "Section" ), Change.Section );
+		( *ChangeObject )->TryGetStringField( TEXT( "Key" ), Change.Key );
+		( *ChangeObject )->TryGetStringArrayField( TEXT( "Lines" ), Change.Lines );
+	}
+
+	return true;
+}
+
+TMap< FString, TFuture< void > > FConfigSyncStore::Compactions;
+FString                          FConfigSyncStore::LockFilePath;
+TMap< FString, FString >         FConfigSyncStore::ParentDirectories;
+FCriticalSection                 FConfigSyncStore::StoreLock;
\ No newline at end of file
@@ -1,9 +1,14 @@
 #include "UConfigSyncSettings.h"
 
 #include "FConfigSync.h"
+#include "FConfigSyncIni.h"
+#include "FConfigSyncStore.h"
+#include "Async/ParallelFor.h"
 #include "JsonObjectConverter.h"
 #include "Macros.h"
 
+#define LOCTEXT_NAMESPACE "ConfigSyncSettings"
+
 UConfigSyncSettings* UConfigSyncSettings::Get()
 {
 	TRACE_CPU_SCOPE;
@@ -12,40 +17,357 @@ UConfigSyncSettings* UConfigSyncSettings::Get()
 	{
 		Instance = GetMutableDefault< UConfigSyncSettings >();
 		Instance->AddToRoot();
+		FConfigSyncStore::SetLockFilePath( FPaths::Combine( GetBaseSettingsDirectory(), "ConfigSync.lock" ) );
+		ConfigureEngineVersionInheritance();
 		Instance->LoadPluginSettings();
+		Instance->LoadPulledSequences();
 		Instance->DiscoverAndAddConfigFiles();
 	}
 
 	return Instance;
 }
 
+void UConfigSyncSettings::Shutdown()
+{
+	TRACE_CPU_SCOPE;
+
+	DisableAutoSync();
+
+	if( ActiveOperation.IsValid() )
+	{
+		ActiveOperation->CancelAndWait();
+		ActiveOperation.Reset();
+	}
+
+	FConfigSyncStore::WaitForCompactions();
+}
+
 void UConfigSyncSettings::DiscoverAndAddConfigFiles()
 {
 	TRACE_CPU_SCOPE;
 
-	IPlatformFile&    PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	TArray< FString > AllConfigPaths;
+	FindConfigFiles( AllConfigPaths, nullptr );
+	AddConfigFiles( AllConfigPaths );
+}
+
+void UConfigSyncSettings::SaveSettingsToGlobal()
+{
+	TRACE_CPU_SCOPE;
+
+	TArray< FConfigSyncFileJob > Jobs;
+	BuildFileJobs( true, Jobs );
+
+	for( const FConfigSyncFileJob& Job: Jobs )
+		PushIniFile( Job.Source, Job.Destination, Job.KeyFilter );
+}
+
+FConfigSyncHotApplyResult UConfigSyncSettings::LoadSettingsFromGlobal()
+{
+	TRACE_CPU_SCOPE;
+
+	TArray< FConfigSyncFileJob > Jobs;
+	BuildFileJobs( false, Jobs );
+
+	TArray< FConfigSyncFileChanges > Changes;
+	for( FConfigSyncFileJob& Job: Jobs )
+		PullFile( Job, ConfigFileSettingsStruct.bHotApplyOnLoad, Changes );
+
+	StorePulledSequences( Jobs );
+
+	FConfigSyncHotApplyResult Result;
+	FConfigSyncHotApply::Apply( Changes, Result );
+	return Result;
+}
+
+TSharedPtr< FConfigSyncOperation > UConfigSyncSettings::DiscoverAndAddConfigFilesAsync( TFunction< void() > OnCompleted )
+{
+	TRACE_CPU_SCOPE;
+
+	if( IsOperationRunning() )
+		return nullptr;
+
+	TSharedRef< TArray< FString > > AllConfigPaths = MakeShared< TArray< FString > >();
+
+	auto Work = [AllConfigPaths]( FConfigSyncOperation& Operation )
+	{
+		FindConfigFiles( *AllConfigPaths, &Operation );
+	};
+
+	auto Completed = [this, AllConfigPaths, OnCompleted = MoveTemp( OnCompleted )]( const bool bCancelled )
+	{
+		FinishOperation();
+		if( !bCancelled )
+			AddConfigFiles( *AllConfigPaths );
+
+		if( OnCompleted )
+			OnCompleted();
+	};
+
+	ActiveOperation = FConfigSyncOperation::Launch( LOCTEXT( "Discovering", "Discovering" ), 0, MoveTemp( Work ), MoveTemp( Completed ) );
+	return ActiveOperation;
+}
+
+TSharedPtr< FConfigSyncOperation > UConfigSyncSettings::SaveSettingsToGlobalAsync( TFunction< void() > OnCompleted )
+{
+	TRACE_CPU_SCOPE;
+
+	if( IsOperationRunning() )
+		return nullptr;
+
+	TSharedRef< TArray< FConfigSyncFileJob > > Jobs = MakeShared< TArray< FConfigSyncFileJob > >();
+	BuildFileJobs( true, *Jobs );
+
+	auto Work = [Jobs]( FConfigSyncOperation& Operation )
+	{
+		for( const FConfigSyncFileJob& Job: *Jobs )
+		{
+			if( Operation.IsCancelled() )
+				return;
+
+			PushIniFile( Job.Source, Job.Destination, Job.KeyFilter );
+			Operation.AddProgress( 1, FMath::Max< int64 >( IFileManager::Get().FileSize( *Job.Source ), 0 ) );
+		}
+	};
+
+	auto Completed = [this, OnCompleted = MoveTemp( OnCompleted )]( bool )
+	{
+		FinishOperation();
+		if( OnCompleted )
+			OnCompleted();
+	};
+
+	ActiveOperation = FConfigSyncOperation::Launch( LOCTEXT( "Saving", "Saving to global" ), Jobs->Num(), MoveTemp( Work ), MoveTemp( Completed ) );
+	return ActiveOperation;
+}
+
+TSharedPtr< FConfigSyncOperation > UConfigSyncSettings::LoadSettingsFromGlobalAsync( TFunction< void( const FConfigSyncHotApplyResult& ) > OnCompleted )
+{
+	TRACE_CPU_SCOPE;
+
+	if( IsOperationRunning() )
+		return nullptr;
+
+	TSharedRef< TArray< FConfigSyncFileJob > > Jobs = MakeShared< TArray< FConfigSyncFileJob > >();
+	BuildFileJobs( false, *Jobs );
+
+	TSharedRef< TArray< FConfigSyncFileChanges > > Changes = MakeShared< TArray< FConfigSyncFileChanges > >();
+
+	auto Work = [Jobs, Changes, bHotApply = ConfigFileSettingsStruct.bHotApplyOnLoad]( FConfigSyncOperation& Operation )
+	{
+		for( FConfigSyncFileJob& Job: *Jobs )
+		{
+			if( Operation.IsCancelled() )
+				return;
+
+			PullFile( Job, bHotApply, *Changes );
+			// The store path is only the compacted base, so the pulled file is what reflects the bytes processed.
+			Operation.AddProgress( 1, FMath::Max< int64 >( IFileManager::Get().FileSize( *Job.Destination ), 0 ) );
+		}
+	};
+
+	// Files pulled before a cancellation are already on disk, so their changes are still hot-applied.
+	auto Completed = [this, Jobs, Changes, OnCompleted = MoveTemp( OnCompleted )]( bool )
+	{
+		FinishOperation();
+		StorePulledSequences( *Jobs );
+
+		FConfigSyncHotApplyResult Result;
+		FConfigSyncHotApply::Apply( *Changes, Result );
+
+		if( OnCompleted )
+			OnCompleted( Result );
+	};
+
+	ActiveOperation = FConfigSyncOperation::Launch( LOCTEXT( "Loading", "Loading from global" ), Jobs->Num(), MoveTemp( Work ), MoveTemp( Completed ) );
+	return ActiveOperation;
+}
+
+TSharedPtr< FConfigSyncOperation > UConfigSyncSettings::FanOutToProjectsAsync( TFunction< void( const TArray< FConfigSyncFanOutResult >& ) > OnCompleted )
+{
+	TRACE_CPU_SCOPE;
+
+	if( IsOperationRunning() )
+		return nullptr;
+
+	TSharedRef< TArray< FConfigSyncFileJob > > PushJobs = MakeShared< TArray< FConfigSyncFileJob > >();
+	BuildFileJobs( true, *PushJobs );
+
+	TSet< FString > StorePaths;
+	for( const FConfigSyncFileJob& Job: *PushJobs )
+		StorePaths.Add( Job.Destination );
+
+	// Read under the store lock, since projects starting up rewrite the registry under it.
+	FConfigSyncProjectRegistry Registry;
+	{
+		const FConfigSyncStore::FScopedLock Lock;
+		if( Lock.IsLocked() && !LoadProjectRegistry( Registry ) )
+			UE_LOG( LogConfigSync, Warning, TEXT( "No project registry to fan out to: %s" ), *GetProjectRegistryFilePath() );
+	}
+
+	TSharedRef< TArray< FConfigSyncFanOutResult > >        Results     = MakeShared< TArray< FConfigSyncFanOutResult > >();
+	TSharedRef< TArray< TArray< FConfigSyncFileJob > > > ProjectJobs = MakeShared< TArray< TArray< FConfigSyncFileJob > > >();
+	int32                                                  FilesTotal  = PushJobs->Num();
+
+	const FString ProjectDir = GetFullProjectDir();
+	for( const FConfigSyncRegisteredProject& Project: Registry.Projects )
+	{
+		if( FPaths::IsSamePath( Project.ProjectDir, ProjectDir ) || !FPaths::DirectoryExists( Project.ProjectDir ) )
+			continue;
+
+		FConfigSyncFanOutResult& Result = Results->AddDefaulted_GetRef();
+		Result.ProjectName              = Project.ProjectName;
+		Result.ProjectDir               = Project.ProjectDir;
+
+		TArray< FConfigSyncFileJob >& Jobs = ProjectJobs->AddDefaulted_GetRef();
+		BuildFanOutJobs( Project, StorePaths, Jobs );
+		FilesTotal += Jobs.Num();
+	}
+
+	auto Work = [PushJobs, ProjectJobs, Results]( FConfigSyncOperation& Operation )
+	{
+		TMap< FString, FString > StoreContents;
+		for( const FConfigSyncFileJob& Job: *PushJobs )
+		{
+			if( Operation.IsCancelled() )
+				return;
+
+			FString Contents;
+			if( PushIniFile( Job.Source, Job.Destination, Job.KeyFilter ) && FConfigSyncStore::Read( Job.Destination, Contents ) )
+				StoreContents.Add( Job.Destination, MoveTemp( Contents ) );
+
+			Operation.AddProgress( 1, FMath::Max< int64 >( IFileManager::Get().FileSize( *Job.Source ), 0 ) );
+		}
+
+		// Every store file is materialized once above, so the projects only touch their own files and never contend on the store lock.
+		ParallelFor( ProjectJobs->Num(), [&]( const int32 ProjectIndex )
+		{
+			FConfigSyncFanOutResult& Result = ( *Results )[ ProjectIndex ];
+			for( const FConfigSyncFileJob& Job: ( *ProjectJobs )[ ProjectIndex ] )
+			{
+				if( Operation.IsCancelled() )
+					return;
+
+				const FString* Contents = StoreContents.Find( Job.Source );
+				if( !Contents )
+				{
+					++Result.FilesFailed;
+					Operation.AddProgress( 1, 0 );
+					continue;
+				}
+
+				FString DestinationContents;
+				const bool bHasDestination = FFileHelper::LoadFileToString( DestinationContents, *Job.Destination );
+
+				FString NewContents;
+				if( Job.KeyFilter.IsEmpty() )
+					NewContents = *Contents;
+				else
+					Job.KeyFilter.Apply( *Contents, DestinationContents, NewContents );
+
+				if( SaveIniFile( Job.Destination, bHasDestination ? &DestinationContents : nullptr, NewContents ) )
+					++Result.FilesApplied;
+				else
+					++Result.FilesFailed;
+
+				Operation.AddProgress( 1, NewContents.Len() );
+			}
+		} );
+	};
+
+	auto Completed = [this, Results, OnCompleted = MoveTemp( OnCompleted )]( bool )
+	{
+		FinishOperation();
+		for( const FConfigSyncFanOutResult& Result: *Results )
+			UE_LOG( LogConfigSync, Log, TEXT( "Fanned out to %s (%s): %d applied, %d failed" ), *Result.ProjectName, *Result.ProjectDir, Result.FilesApplied, Result.FilesFailed );
+
+		if( OnCompleted )
+			OnCompleted( *Results );
+	};
+
+	ActiveOperation = FConfigSyncOperation::Launch( LOCTEXT( "FanningOut", "Fanning out to projects" ), FilesTotal, MoveTemp( Work ), MoveTemp( Completed ) );
+	return ActiveOperation;
+}
+
+void UConfigSyncSettings::OnSettingsChanged()
+{
+	TRACE_CPU_SCOPE;
+
+	// The running operation reads and writes the same project and store files, so the push waits until it has finished.
+	if( IsOperationRunning() )
+	{
+		bSettingsChangedDuringOperation = true;
+		return;
+	}
+
+	KeyFilters.Reset();
+	FileStates.Reset();
+	bAutoSyncScheduleDirty = true;
+
+	SavePluginSettings();
+	SaveSettingsToGlobal();
+}
+
+void UConfigSyncSettings::FinishOperation()
+{
+	TRACE_CPU_SCOPE;
+
+	ActiveOperation.Reset();
+	if( !bSettingsChangedDuringOperation )
+		return;
+
+	bSettingsChangedDuringOperation = false;
+	OnSettingsChanged();
+}
+
+void UConfigSyncSettings::FindConfigFiles( TArray< FString >& OutConfigPaths, FConfigSyncOperation* Operation )
+{
+	TRACE_CPU_SCOPE;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 
 	static const FString ProjectConfigDir = FPaths::ProjectConfigDir();
 	TArray< FString >    ConfigDirFiles;
 	PlatformFile.FindFiles( ConfigDirFiles, *ProjectConfigDir, TEXT( ".ini" ) );
 
 	for( const FString& FilePath: ConfigDirFiles )
-		AllConfigPaths.AddUnique( FilePath );
+		OutConfigPaths.AddUnique( FilePath );
+
+	if( Operation )
+	{
+		Operation->AddProgress( ConfigDirFiles.Num(), 0 );
+		if( Operation->IsCancelled() )
+			return;
+	}
 
 	static const FString SavedConfigDir = FPaths::Combine( FPaths::ProjectSavedDir(), "Config" );
 	TArray< FString >    SavedConfigFiles;
 	PlatformFile.FindFilesRecursively( SavedConfigFiles, *SavedConfigDir, TEXT( ".ini" ) );
 
 	for( const FString& FilePath: SavedConfigFiles )
-		AllConfigPaths.AddUnique( FilePath );
+		OutConfigPaths.AddUnique( FilePath );
+
+	if( Operation )
+	{
+		Operation->AddProgress( SavedConfigFiles.Num(), 0 );
+		if( Operation->IsCancelled() )
+			return;
+	}
 
 	static const FString PluginsDir = FPaths::ProjectPluginsDir();
 	TArray< FString >    PluginConfigFiles;
 	PlatformFile.FindFilesRecursively( PluginConfigFiles, *PluginsDir, TEXT( ".ini" ) );
 
 	for( const FString& FilePath: PluginConfigFiles )
-		AllConfigPaths.AddUnique( FilePath );
+		OutConfigPaths.AddUnique( FilePath );
+
+	if( Operation )
+		Operation->AddProgress( PluginConfigFiles.Num(), 0 );
+}
+
+void UConfigSyncSettings::AddConfigFiles( TArray< FString >& ConfigPaths )
+{
+	TRACE_CPU_SCOPE;
 
 	TSet< FString > ExistingFileNames;
 	for( const FConfigFileSettings& Filter: ConfigFileSettingsStruct.Settings )
@@ -53,7 +375,7 @@ void UConfigSyncSettings::DiscoverAndAddConfigFiles()
 
 	static const FString ProjectDir = FPaths::ProjectDir();
 	int32                FilesAdded = 0;
-	for( FString& ConfigPath: AllConfigPaths )
+	for( FString& ConfigPath: ConfigPaths )
 	{
 		const FString Filename = FPaths::GetCleanFilename( ConfigPath );
 		if( ExistingFileNames.Contains( Filename ) )
@@ -73,7 +395,7 @@ void UConfigSyncSettings::DiscoverAndAddConfigFiles()
 		SavePluginSettings();
 }
 
-void UConfigSyncSettings::SaveSettingsToGlobal()
+void UConfigSyncSettings::BuildFileJobs( const bool bToGlobal, TArray< FConfigSyncFileJob >& OutJobs )
 {
 	TRACE_CPU_SCOPE;
 
@@ -83,34 +405,69 @@ void UConfigSyncSettings::SaveSettingsToGlobal()
 		if( !Setting.bEnabled )
 			continue;
 
-		const FString Source      = FPaths::Combine( ProjectDir, Setting.RelativePath );
-		const FString Destination = FPaths::Combine( GetScopedSettingsDirectory( Setting.SettingsScope ), Setting.RelativePath );
-		CopyIniFile( Source, Destination );
+		const FString ProjectPath = FPaths::Combine( ProjectDir, Setting.RelativePath );
+		const FString GlobalPath  = FPaths::Combine( GetScopedSettingsDirectory( Setting.SettingsScope ), Setting.RelativePath );
+
+		FConfigSyncFileJob& Job = OutJobs.AddDefaulted_GetRef();
+		Job.Source              = bToGlobal ? ProjectPath : GlobalPath;
+		Job.Destination         = bToGlobal ? GlobalPath : ProjectPath;
+		Job.KeyFilter           = GetKeyFilter( Setting );
+
+		if( const FConfigSyncPulledFile* PulledFile = PulledSequences.Files.Find( GlobalPath ) )
+		{
+			Job.PulledHead.Generation = PulledFile->Generation;
+			Job.PulledHead.Sequence   = PulledFile->Sequence;
+		}
 	}
 }
 
-void UConfigSyncSettings::LoadSettingsFromGlobal()
+void UConfigSyncSettings::StorePulledSequences( const TArray< FConfigSyncFileJob >& Jobs )
 {
 	TRACE_CPU_SCOPE;
 
-	static const FString ProjectDir = FPaths::ProjectDir();
-	for( const FConfigFileSettings& Setting: ConfigFileSettingsStruct.Settings )
+	bool bChanged = false;
+	for( const FConfigSyncFileJob& Job: Jobs )
 	{
-		if( !Setting.bEnabled )
+		if( Job.PulledHead.Sequence == INDEX_NONE )
 			continue;
 
-		const FString Source      = FPaths::Combine( GetScopedSettingsDirectory( Setting.SettingsScope ), Setting.RelativePath );
-		const FString Destination = FPaths::Combine( ProjectDir, Setting.RelativePath );
-		CopyIniFile( Source, Destination );
+		FConfigSyncPulledFile& PulledFile = PulledSequences.Files.FindOrAdd( Job.Source );
+		if( PulledFile.Sequence == Job.PulledHead.Sequence && PulledFile.Generation.Equals( Job.PulledHead.Generation, ESearchCase::CaseSensitive ) )
+			continue;
+
+		PulledFile.Generation = Job.PulledHead.Generation;
+		PulledFile.Sequence   = Job.PulledHead.Sequence;
+		bChanged              = true;
 	}
+
+	if( bChanged )
+		SavePulledSequences();
 }
 
-void UConfigSyncSettings::OnSettingsChanged()
+bool UConfigSyncSettings::PullFile( FConfigSyncFileJob& Job, const bool bHotApply, TArray< FConfigSyncFileChanges >& OutChanges )
 {
 	TRACE_CPU_SCOPE;
 
-	SavePluginSettings();
-	SaveSettingsToGlobal();
+	FString OldContents;
+	if( bHotApply )
+		FFileHelper::LoadFileToString( OldContents, *Job.Destination );
+
+	// A failed write, e.g. to a read-only file checked out from source control, must not record a sequence, or the next pull would skip the deltas it lost.
+	if( !PullIniFile( Job.Source, Job.Destination, Job.KeyFilter, Job.PulledHead ) )
+	{
+		Job.PulledHead = FConfigSyncStoreHead();
+		return false;
+	}
+
+	FString NewContents;
+	if( !bHotApply || !FFileHelper::LoadFileToString( NewContents, *Job.Destination ) )
+		return true;
+
+	FConfigSyncFileChanges FileChanges;
+	if( FConfigSyncHotApply::CollectChanges( Job.Destination, OldContents, NewContents, FileChanges ) )
+		OutChanges.Add( MoveTemp( FileChanges ) );
+
+	return true;
 }
 
 void UConfigSyncSettings::SavePluginSettings() const
@@ -146,25 +503,190 @@ void UConfigSyncSettings::LoadPluginSettings()
 	TRACE_CPU_SCOPE;
 
 	const FString SettingsFilePath = GetPluginSettingsFilePath();
+	if( LoadSettingsFile( SettingsFilePath, ConfigFileSettingsStruct ) )
+		UE_LOG( LogConfigSync, Log, TEXT( "Plugin settings loaded from: %s" ), *SettingsFilePath );
+}
+
+void UConfigSyncSettings::SavePulledSequences() const
+{
+	TRACE_CPU_SCOPE;
+
+	const FString SequencesFilePath = GetPulledSequencesFilePath();
+	if( !EnsureDirectoryExists( FPaths::GetPath( SequencesFilePath ) ) )
+	{
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to create directory: %s" ), *FPaths::GetPath( SequencesFilePath ) );
+		return;
+	}
+
+	FString OutputString;
+	if( !FJsonObjectConverter::UStructToJsonObjectString( PulledSequences, OutputString ) )
+	{
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to convert pulled sequences JSON: %s" ), *SequencesFilePath );
+		return;
+	}
+
+	if( !FFileHelper::SaveStringToFile( OutputString, *SequencesFilePath ) )
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to write pulled sequences: %s" ), *SequencesFilePath );
+}
+
+void UConfigSyncSettings::LoadPulledSequences()
+{
+	TRACE_CPU_SCOPE;
+
+	const FString SequencesFilePath = GetPulledSequencesFilePath();
+
+	FString JsonString;
+	if( !FFileHelper::LoadFileToString( JsonString, *SequencesFilePath ) )
+		return;
+
+	if( !FJsonObjectConverter::JsonObjectStringToUStruct( JsonString, &PulledSequences ) )
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to convert pulled sequences JSON: %s" ), *SequencesFilePath );
+}
+
+bool UConfigSyncSettings::LoadSettingsFile( const FString& SettingsFilePath, FConfigFileSettingsStruct& OutSettings )
+{
+	TRACE_CPU_SCOPE;
 
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 	if( !PlatformFile.FileExists( *SettingsFilePath ) )
-		return;
+		return false;
 
 	FString JsonString;
 	if( !FFileHelper::LoadFileToString( JsonString, *SettingsFilePath ) )
 	{
 		UE_LOG( LogConfigSync, Error, TEXT( "Failed to read settings file: %s" ), *SettingsFilePath );
-		return;
+		return false;
 	}
 
-	if( !FJsonObjectConverter::JsonObjectStringToUStruct( JsonString, &ConfigFileSettingsStruct ) )
+	if( !FJsonObjectConverter::JsonObjectStringToUStruct( JsonString, &OutSettings ) )
 	{
 		UE_LOG( LogConfigSync, Error, TEXT( "Failed to convert settings JSON: %s" ), *SettingsFilePath );
+		return false;
+	}
+
+	return true;
+}
+
+void UConfigSyncSettings::RegisterProject()
+{
+	TRACE_CPU_SCOPE;
+
+	// Editors starting at the same time would otherwise each drop the other's registration.
+	const FConfigSyncStore::FScopedLock Lock;
+	if( !Lock.IsLocked() )
+		return;
+
+	FConfigSyncProjectRegistry Registry;
+	LoadProjectRegistry( Registry );
+
+	// Checkouts that were deleted or moved drop out here, since every live project re-registers on its next startup.
+	const FString ProjectDir = GetFullProjectDir();
+	Registry.Projects.RemoveAll( [&ProjectDir]( const FConfigSyncRegisteredProject& Project )
+	{
+		return FPaths::IsSamePath( Project.ProjectDir, ProjectDir ) || !FPaths::DirectoryExists( Project.ProjectDir );
+	} );
+
+	FConfigSyncRegisteredProject& Project = Registry.Projects.AddDefaulted_GetRef();
+	Project.ProjectName                   = FApp::GetProjectName();
+	Project.ProjectDir                    = ProjectDir;
+	Project.EngineVersion                 = GetEngineVersionName();
+
+	SaveProjectRegistry( Registry );
+}
+
+void UConfigSyncSettings::ConfigureEngineVersionInheritance()
+{
+	TRACE_CPU_SCOPE;
+
+	const FString EngineVersionsDir = FPaths::Combine( GetBaseSettingsDirectory(), "PerEngineVersion" );
+
+	TArray< FString > VersionNames;
+	IFileManager::Get().FindFiles( VersionNames, *FPaths::Combine( EngineVersionsDir, TEXT( "*" ) ), false, true );
+	VersionNames.AddUnique( GetEngineVersionName() );
+
+	TArray< FIntPoint > Versions;
+	for( const FString& VersionName: VersionNames )
+	{
+		FString Major;
+		FString Minor;
+		if( VersionName.Split( TEXT( "." ), &Major, &Minor ) && Major.IsNumeric() && Minor.IsNumeric() )
+			Versions.Add( FIntPoint( FCString::Atoi( *Major ), FCString::Atoi( *Minor ) ) );
+	}
+
+	Versions.Sort( []( const FIntPoint& A, const FIntPoint& B ) { return A.X != B.X ? A.X < B.X : A.Y < B.Y; } );
+
+	// Each version reads through to the nearest older one, so a fresh engine version starts out with everything the previous one had stored.
+	for( int32 i = 1; i < Versions.Num(); ++i )
+	{
+		const FString Directory       = FPaths::Combine( EngineVersionsDir, FString::Printf( TEXT( "%d.%d" ), Versions[ i ].X, Versions[ i ].Y ) );
+		const FString ParentDirectory = FPaths::Combine( EngineVersionsDir, FString::Printf( TEXT( "%d.%d" ), Versions[ i - 1 ].X, Versions[ i - 1 ].Y ) );
+		FConfigSyncStore::SetParentDirectory( Directory, ParentDirectory );
+	}
+}
+
+bool UConfigSyncSettings::LoadProjectRegistry( FConfigSyncProjectRegistry& OutRegistry )
+{
+	TRACE_CPU_SCOPE;
+
+	const FString RegistryFilePath = GetProjectRegistryFilePath();
+
+	FString JsonString;
+	if( !FFileHelper::LoadFileToString( JsonString, *RegistryFilePath ) )
+		return false;
+
+	if( !FJsonObjectConverter::JsonObjectStringToUStruct( JsonString, &OutRegistry ) )
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to convert project registry JSON: %s" ), *RegistryFilePath );
+
+	return true;
+}
+
+void UConfigSyncSettings::SaveProjectRegistry( const FConfigSyncProjectRegistry& Registry )
+{
+	TRACE_CPU_SCOPE;
+
+	const FString RegistryFilePath = GetProjectRegistryFilePath();
+	if( !EnsureDirectoryExists( FPaths::GetPath( RegistryFilePath ) ) )
+	{
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to create settings directory: %s" ), *FPaths::GetPath( RegistryFilePath ) );
 		return;
 	}
 
-	UE_LOG( LogConfigSync, Log, TEXT( "Plugin settings loaded from: %s" ), *SettingsFilePath );
+	FString OutputString;
+	if( !FJsonObjectConverter::UStructToJsonObjectString( Registry, OutputString ) )
+	{
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to convert project registry JSON: %s" ), *RegistryFilePath );
+		return;
+	}
+
+	// Readers and writers both hold the store lock, so the registry is never seen half-written.
+	if( !FFileHelper::SaveStringToFile( OutputString, *RegistryFilePath ) )
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to write project registry: %s" ), *RegistryFilePath );
+}
+
+void UConfigSyncSettings::BuildFanOutJobs( const FConfigSyncRegisteredProject& Project, const TSet< FString >& StorePaths, TArray< FConfigSyncFileJob >& OutJobs )
+{
+	TRACE_CPU_SCOPE;
+
+	FConfigFileSettingsStruct ProjectSettings;
+	if( !LoadSettingsFile( GetPluginSettingsFilePath( Project.ProjectName ), ProjectSettings ) )
+		return;
+
+	// Pulled sequences live in each checkout's Saved directory and belong to its own editor, so fan-out jobs always apply the full file and never update them.
+	// The target's next Load therefore re-pulls from its last recorded sequence, or does a full read, which only re-applies what fan-out already wrote.
+	for( const FConfigFileSettings& Setting: ProjectSettings.Settings )
+	{
+		if( !Setting.bEnabled )
+			continue;
+
+		const FString StorePath = FPaths::Combine( GetScopedSettingsDirectory( Setting.SettingsScope, Project.EngineVersion, Project.ProjectName ), Setting.RelativePath );
+		if( !StorePaths.Contains( StorePath ) )
+			continue;
+
+		FConfigSyncFileJob& Job = OutJobs.AddDefaulted_GetRef();
+		Job.Source              = StorePath;
+		Job.Destination         = FPaths::Combine( Project.ProjectDir, Setting.RelativePath );
+		Job.KeyFilter           = FConfigSyncKeyFilter( ProjectSettings.KeyRules, Setting.RelativePath );
+	}
 }
 
 void UConfigSyncSettings::EnableAutoSync()
@@ -174,7 +696,7 @@ void UConfigSyncSettings::EnableAutoSync()
 	if( AutoSyncHandle.IsValid() )
 		return;
 
-	AutoSyncHandle = FTSTicker::GetCoreTicker().AddTicker( FTickerDelegate::CreateUObject( this, &UConfigSyncSettings::AutoSyncTick ), 10 );
+	AutoSyncHandle = FTSTicker::GetCoreTicker().AddTicker( FTickerDelegate::CreateUObject( this, &UConfigSyncSettings::AutoSyncTick ), 1 );
 }
 
 void UConfigSyncSettings::DisableAutoSync() const
@@ -188,39 +710,183 @@ bool UConfigSyncSettings::AutoSyncTick( const float DeltaTime )
 {
 	TRACE_CPU_SCOPE;
 
-	IFileManager& FileManager = IFileManager::Get();
+	if( IsOperationRunning() )
+		return true;
+
+	if( bAutoSyncScheduleDirty )
+		RebuildAutoSyncSchedule();
+
+	const double      Now = FPlatformTime::Seconds();
+	TArray< FString > DueFiles;
+	AutoSyncScheduler.PopDue( Now, ConfigFileSettingsStruct.AutoSyncFilesPerTick, DueFiles );
+
+	for( const FString& RelativePath: DueFiles )
+	{
+		const int32* SettingIndex = AutoSyncSettingIndices.Find( RelativePath );
+		if( SettingIndex && ConfigFileSettingsStruct.Settings.IsValidIndex( *SettingIndex ) )
+			AutoSyncScheduler.Reschedule( RelativePath, Now, AutoSyncFile( ConfigFileSettingsStruct.Settings[ *SettingIndex ] ) );
+	}
+
+	return true;
+}
+
+bool UConfigSyncSettings::AutoSyncFile( const FConfigFileSettings& Setting )
+{
+	TRACE_CPU_SCOPE;
 
 	static const FString ProjectDir = FPaths::ProjectDir();
+
+	const FString Source      = FPaths::Combine( ProjectDir, Setting.RelativePath );
+	const FString Destination = FPaths::Combine( GetScopedSettingsDirectory( Setting.SettingsScope ), Setting.RelativePath );
+
+	const FFileStatData   SourceStat = IFileManager::Get().GetStatData( *Source );
+	FConfigSyncFileState& FileState  = FileStates.FindOrAdd( Setting.RelativePath );
+	if( !SourceStat.bIsValid || ( SourceStat.ModificationTime == FileState.SourceTimestamp && SourceStat.FileSize == FileState.SourceSize ) )
+		return false;
+
+	// The file state only advances once the source is in the store, so a failed read or push is retried on the next check.
+	FString SourceContents;
+	if( !FFileHelper::LoadFileToString( SourceContents, *Source ) )
+		return false;
+
+	// Only edits that survive the key filter count as changes, so a file the editor rewrites with ignored keys still backs off.
+	const FConfigSyncKeyFilter& KeyFilter  = GetKeyFilter( Setting );
+	const uint64                SourceHash = FConfigSyncIni::CanonicalHash( SourceContents, &KeyFilter );
+	const bool                  bChanged   = FileState.SourceHash.IsSet() && FileState.SourceHash.GetValue() != SourceHash;
+	if( !FileState.SourceHash.IsSet() || bChanged )
+	{
+		FString StoreContents;
+		FConfigSyncStore::Read( Destination, StoreContents );
+
+		if( SourceHash != FConfigSyncIni::CanonicalHash( StoreContents, &KeyFilter ) && !PushIniFile( Source, Destination, KeyFilter ) )
+		{
+			UE_LOG( LogConfigSync, Error, TEXT( "Failed to auto-sync %s to: %s" ), *Source, *Destination );
+			return bChanged;
+		}
+	}
+
+	FileState.SourceTimestamp = SourceStat.ModificationTime;
+	FileState.SourceSize      = SourceStat.FileSize;
+	FileState.SourceHash      = SourceHash;
+	return bChanged;
+}
+
+void UConfigSyncSettings::RebuildAutoSyncSchedule()
+{
+	TRACE_CPU_SCOPE;
+
+	bAutoSyncScheduleDirty = false;
+
+	AutoSyncSettingIndices.Reset();
+	AutoSyncScheduler.SetIntervals( ConfigFileSettingsStruct.AutoSyncMinInterval, ConfigFileSettingsStruct.AutoSyncMaxInterval );
+
+	// Only membership is rebuilt: files that stay tracked keep the interval they have learned, so a settings change does not trigger a full sweep.
+	TSet< FString > TrackedFiles;
 	for( const FConfigFileSettings& Setting: ConfigFileSettingsStruct.Settings )
 	{
+		if( Setting.bEnabled && Setting.bAutoSyncEnabled )
+			TrackedFiles.Add( Setting.RelativePath );
+	}
+	AutoSyncScheduler.Retain( TrackedFiles );
+
+	IFileManager&        FileManager = IFileManager::Get();
+	const double         Now         = FPlatformTime::Seconds();
+	const FDateTime      UtcNow      = FDateTime::UtcNow();
+	static const FString ProjectDir  = FPaths::ProjectDir();
+	for( int32 i = 0; i < ConfigFileSettingsStruct.Settings.Num(); ++i )
+	{
+		const FConfigFileSettings& Setting = ConfigFileSettingsStruct.Settings[ i ];
 		if( !Setting.bEnabled || !Setting.bAutoSyncEnabled )
 			continue;
 
-		const FString Source      = FPaths::Combine( ProjectDir, Setting.RelativePath );
-		const FString Destination = FPaths::Combine( GetScopedSettingsDirectory( Setting.SettingsScope ), Setting.RelativePath );
-
-		if( FileManager.FileSize( *Source ) == FileManager.FileSize( *Destination ) )
+		AutoSyncSettingIndices.Add( Setting.RelativePath, i );
+		if( AutoSyncScheduler.Contains( Setting.RelativePath ) )
 			continue;
 
-		CopyIniFile( Source, Destination );
+		// Seed the interval from how long the file has been untouched so files that have been cold for days start out backed off.
+		const FDateTime SourceTimestamp = FileManager.GetTimeStamp( *FPaths::Combine( ProjectDir, Setting.RelativePath ) );
+		const double    ColdSeconds     = SourceTimestamp == FDateTime::MinValue() ? 0 : ( UtcNow - SourceTimestamp ).GetTotalSeconds();
+		AutoSyncScheduler.Add( Setting.RelativePath, Now, ColdSeconds / 10 );
 	}
+}
 
-	return true;
+const FConfigSyncKeyFilter& UConfigSyncSettings::GetKeyFilter( const FConfigFileSettings& Setting )
+{
+	TRACE_CPU_SCOPE;
+
+	if( const FConfigSyncKeyFilter* KeyFilter = KeyFilters.Find( Setting.RelativePath ) )
+		return *KeyFilter;
+
+	return KeyFilters.Add( Setting.RelativePath, FConfigSyncKeyFilter( ConfigFileSettingsStruct.KeyRules, Setting.RelativePath ) );
 }
 
-bool UConfigSyncSettings::CopyIniFile( const FString& Source, const FString& Destination )
+bool UConfigSyncSettings::PushIniFile( const FString& Source, const FString& StorePath, const FConfigSyncKeyFilter& KeyFilter )
 {
 	TRACE_CPU_SCOPE;
 
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FString SourceContents;
+	if( !FFileHelper::LoadFileToString( SourceContents, *Source ) )
+		return false;
+
+	if( KeyFilter.IsEmpty() )
+		return FConfigSyncStore::Write( StorePath, SourceContents );
+
+	FString StoreContents;
+	FConfigSyncStore::Read( StorePath, StoreContents );
+
+	FString FilteredContents;
+	KeyFilter.Apply( SourceContents, StoreContents, FilteredContents );
+	return FConfigSyncStore::Write( StorePath, FilteredContents );
+}
 
-	if( !PlatformFile.FileExists( *Source ) )
+bool UConfigSyncSettings::PullIniFile( const FString& StorePath, const FString& Destination, const FConfigSyncKeyFilter& KeyFilter, FConfigSyncStoreHead& InOutHead )
+{
+	TRACE_CPU_SCOPE;
+
+	FString DestinationContents;
+	const bool bHasDestination = FFileHelper::LoadFileToString( DestinationContents, *Destination );
+
+	FString                        NewContents;
+	TArray< FConfigSyncIniChange > Changes;
+	FConfigSyncStoreHead           Head;
+	if( bHasDestination && FConfigSyncStore::ReadChangesSince( StorePath, InOutHead, Changes, Head ) )
+	{
+		Changes.RemoveAll( [&KeyFilter]( const FConfigSyncIniChange& Change ) { return KeyFilter.IsExcluded( Change.Section, Change.Key ); } );
+		FConfigSyncIni::ApplyChanges( DestinationContents, Changes, NewContents );
+	}
+	else
+	{
+		FString StoreContents;
+		if( !FConfigSyncStore::Read( StorePath, StoreContents, &Head ) )
+			return false;
+
+		if( KeyFilter.IsEmpty() )
+			NewContents = MoveTemp( StoreContents );
+		else
+			KeyFilter.Apply( StoreContents, DestinationContents, NewContents );
+	}
+
+	if( !SaveIniFile( Destination, bHasDestination ? &DestinationContents : nullptr, NewContents ) )
+	{
+		UE_LOG( LogConfigSync, Error, TEXT( "Failed to write pulled file: %s" ), *Destination );
 		return false;
+	}
+
+	InOutHead = MoveTemp( Head );
+	return true;
+}
+
+bool UConfigSyncSettings::SaveIniFile( const FString& Destination, const FString* OldContents, const FString& NewContents )
+{
+	TRACE_CPU_SCOPE;
+
+	if( OldContents && NewContents.Equals( *OldContents, ESearchCase::CaseSensitive ) )
+		return true;
 
 	if( !EnsureDirectoryExists( FPaths::GetPath( Destination ) ) )
 		return false;
 
-	return PlatformFile.CopyFile( *Destination, *Source );
+	return FFileHelper::SaveStringToFile( NewContents, *Destination );
 }
 
 bool UConfigSyncSettings::EnsureDirectoryExists( const FString& DirectoryPath )
@@ -235,23 +901,33 @@ bool UConfigSyncSettings::EnsureDirectoryExists( const FString& DirectoryPath )
 	return PlatformFile.CreateDirectoryTree( *DirectoryPath );
 }
 
-FString UConfigSyncSettings::GetScopedSettingsDirectory( const EConfigSyncScope Scope )
+FString UConfigSyncSettings::GetBaseSettingsDirectory()
 {
 	TRACE_CPU_SCOPE;
 
 	static FString UserSettingsDir = FPlatformProcess::UserSettingsDir();
-	FString        BaseDir         = FPaths::Combine( UserSettingsDir, "UnrealEngine", "ConfigSync" );
+	return FPaths::Combine( UserSettingsDir, "UnrealEngine", "ConfigSync" );
+}
+
+FString UConfigSyncSettings::GetScopedSettingsDirectory( const EConfigSyncScope Scope )
+{
+	TRACE_CPU_SCOPE;
+	return GetScopedSettingsDirectory( Scope, GetEngineVersionName(), FApp::GetProjectName() );
+}
+
+FString UConfigSyncSettings::GetScopedSettingsDirectory( const EConfigSyncScope Scope, const FString& EngineVersion, const FString& ProjectName )
+{
+	TRACE_CPU_SCOPE;
+
+	const FString BaseDir = GetBaseSettingsDirectory();
 	switch( Scope )
 	{
 		case EConfigSyncScope::Global:
 			return FPaths::Combine( BaseDir, "Global" );
 		case EConfigSyncScope::PerEngineVersion:
-		{
-			static FString EngineVersion = FString::Printf( TEXT( "%d.%d" ), ENGINE_MAJOR_VERSION, ENGINE_MINOR_VERSION );
 			return FPaths::Combine( BaseDir, "PerEngineVersion", EngineVersion );
-		}
 		case EConfigSyncScope::PerProject:
-			return FPaths::Combine( BaseDir, "PerProject", FApp::GetProjectName() );
+			return FPaths::Combine( BaseDir, "PerProject", ProjectName );
 		default:
 			return BaseDir;
 	}
@@ -260,7 +936,43 @@ FString UConfigSyncSettings::GetScopedSettingsDirectory( const EConfigSyncScope
 FString UConfigSyncSettings::GetPluginSettingsFilePath()
 {
 	TRACE_CPU_SCOPE;
-	return FPaths::Combine( GetScopedSettingsDirectory( EConfigSyncScope::PerProject ), "ConfigSyncSettings.json" );
+	return GetPluginSettingsFilePath( FApp::GetProjectName() );
+}
+
+FString UConfigSyncSettings::GetPluginSettingsFilePath( const FString& ProjectName )
+{
+	TRACE_CPU_SCOPE;
+	return FPaths::Combine( GetBaseSettingsDirectory(), "PerProject", ProjectName, "ConfigSyncSettings.json" );
+}
+
+FString UConfigSyncSettings::GetProjectRegistryFilePath()
+{
+	TRACE_CPU_SCOPE;
+	return FPaths::Combine( GetBaseSettingsDirectory(), "ProjectRegistry.json" );
+}
+
+FString UConfigSyncSettings::GetPulledSequencesFilePath()
+{
+	TRACE_CPU_SCOPE;
+	return FPaths::Combine( FPaths::ProjectSavedDir(), "ConfigSync", "PulledSequences.json" );
 }
 
-UConfigSyncSettings* UConfigSyncSettings::Instance = nullptr;
\ No newline at end of file
+FString UConfigSyncSettings::GetEngineVersionName()
+{
+	TRACE_CPU_SCOPE;
+
+	static FString EngineVersion = FString::Printf( TEXT( "%d.%d" ), ENGINE_MAJOR_VERSION, ENGINE_MINOR_VERSION );
+	return EngineVersion;
+}
+
+FString UConfigSyncSettings::GetFullProjectDir()
+{
+	TRACE_CPU_SCOPE;
+
+	static FString ProjectDir = FPaths::ConvertRelativePathToFull( FPaths::ProjectDir() );
+	return ProjectDir;
+}
+
+UConfigSyncSettings* UConfigSyncSettings::Instance = nullptr;
+
+#undef LOCTEXT_NAMESPACE
\ No newline at end of file
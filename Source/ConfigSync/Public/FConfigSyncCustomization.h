@@ -3,8 +3,12 @@
 #include "CoreMinimal.h"
 #include "IDetailCustomization.h"
 
+class FConfigSyncOperation;
+class IDetailCategoryBuilder;
 class IDetailLayoutBuilder;
 class UConfigSyncSettings;
+struct FConfigSyncFanOutResult;
+struct FConfigSyncHotApplyResult;
 
 struct FPropertyHandles
 {
@@ -33,8 +37,18 @@ public:
 	virtual void CustomizeDetails( IDetailLayoutBuilder& DetailBuilder ) override;
 
 private:
+	void AddOptionProperty( IDetailCategoryBuilder& Category, const TSharedRef< IPropertyHandle >& StructHandle, FName PropertyName );
 	void RefreshTreeData( const IDetailLayoutBuilder& DetailBuilder );
 
+	bool                               CanStartOperation() const;
+	TSharedPtr< FConfigSyncOperation > GetActiveOperation() const;
+
+	TWeakPtr< STreeView< TSharedRef< FConfigTreeItem > > > GetWeakTreeView() const { return TreeView; }
+
+	static void RequestTreeRefresh( const TWeakPtr< STreeView< TSharedRef< FConfigTreeItem > > >& WeakTreeView );
+	static void ShowHotApplyNotification( const FConfigSyncHotApplyResult& Result );
+	static void ShowFanOutNotification( const TArray< FConfigSyncFanOutResult >& Results );
+
 	TSharedRef< ITableRow > OnGenerateRow( TSharedRef< FConfigTreeItem > InItem, const TSharedRef< STableViewBase >& OwnerTable ) const;
 	void                    OnGetChildren( TSharedRef< FConfigTreeItem > InItem, TArray< TSharedRef< FConfigTreeItem > >& OutChildren ) { OutChildren = InItem->Children; }
 
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FConfigSyncFileChanges
+{
+	FString                            FilePath;
+	TMap< FString, TSet< FString > > ChangedKeys;
+};
+
+struct FConfigSyncHotApplyResult
+{
+	TArray< FString > AppliedSections;
+	TArray< FString > RestartRequired;
+};
+
+class FConfigSyncHotApply
+{
+public:
+	static bool CollectChanges( const FString& FilePath, const FString& OldContents, const FString& NewContents, FConfigSyncFileChanges& OutChanges );
+
+	// Reloads only the GConfig branches touched by the changes, then reloads the class defaults and console variables bound to the changed sections.
+	static void Apply( const TArray< FConfigSyncFileChanges >& Changes, FConfigSyncHotApplyResult& OutResult );
+
+private:
+	static bool ApplySection( const FString& BranchFilename, const FString& SectionName );
+
+	static FString GetBranchName( const FString& FilePath );
+};
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FConfigSyncKeyFilter;
+
+enum class EConfigSyncIniToken : uint8
+{
+	Blank,
+	Comment,
+	Section,
+	Entry,
+};
+
+struct FConfigSyncIniLine
+{
+	EConfigSyncIniToken Token;
+	FStringView         Line;
+	FStringView         Section;
+	FStringView         Key;
+	FStringView         Value;
+};
+
+struct FConfigSyncIniEntry
+{
+	FString Key;
+	FString Value;
+};
+
+struct FConfigSyncIniSection
+{
+	FString                       Name;
+	TArray< FConfigSyncIniEntry > Entries;
+};
+
+// Replaces every line of one key (including its array operator lines) inside a section. Empty Lines removes the key.
+struct FConfigSyncIniChange
+{
+	FString           Section;
+	FString           Key;
+	TArray< FString > Lines;
+};
+
+class FConfigSyncIni
+{
+public:
+	// Visits every line without building an intermediate representation. Section, Key and Value are trimmed views into Contents.
+	static void Stream( FStringView Contents, TFunctionRef< void( const FConfigSyncIniLine& ) > Visitor );
+
+	static void Parse( const FString& Contents, TArray< FConfigSyncIniSection >& OutSections );
+
+	// Produces a formatting-independent form: sections and keys sorted case-insensitively, comments and whitespace dropped, the order of repeated and array-operator
+	// (+, -, !) lines within a key preserved. Keys excluded by KeyFilter are left out.
+	static void   Canonicalize( FStringView Contents, FString& OutCanonical, const FConfigSyncKeyFilter* KeyFilter = nullptr );
+	static uint64 CanonicalHash( FStringView Contents, const FConfigSyncKeyFilter* KeyFilter = nullptr );
+
+	// Collects every key whose values differ between the two files, keyed by section name. Array operators (+, -, !, ., @) are folded into the base key name.
+	static void Diff( const TArray< FConfigSyncIniSection >& OldSections, const TArray< FConfigSyncIniSection >& NewSections, TMap< FString, TSet< FString > >& OutChangedKeys );
+
+	static void MakeChanges( const TArray< FConfigSyncIniSection >& OldSections, const TArray< FConfigSyncIniSection >& NewSections, TArray< FConfigSyncIniChange >& OutChanges );
+
+	// Streams Contents into OutContents with the changes patched in place; later changes to the same key win. Keys in sections that do not exist yet are appended.
+	// Without changes Contents is returned byte for byte.
+	static void ApplyChanges( FStringView Contents, const TArray< FConfigSyncIniChange >& Changes, FString& OutContents );
+
+	static FStringView GetBaseKeyName( FStringView Key );
+};
\ No newline at end of file
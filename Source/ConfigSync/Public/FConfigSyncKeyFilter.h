@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FConfigSyncKeyRule;
+
+class FConfigSyncKeyFilter
+{
+public:
+	FConfigSyncKeyFilter() = default;
+	FConfigSyncKeyFilter( const TArray< FConfigSyncKeyRule >& Rules, const FString& RelativePath );
+
+	bool IsEmpty() const { return !bHasExcludeRules; }
+	bool IsExcluded( FStringView Section, FStringView Key ) const;
+
+	// Streams Source into OutContents, dropping excluded keys and carrying over the excluded keys already present in Destination.
+	void Apply( const FString& Source, const FString& Destination, FString& OutContents ) const;
+
+private:
+	struct FPattern
+	{
+		enum class EKind : uint8
+		{
+			Any,
+			Exact,
+			Prefix,
+			Suffix,
+			Contains,
+			Wildcard,
+		};
+
+		EKind   Kind = EKind::Any;
+		FString Text;
+
+		static FPattern Compile( const FString& Pattern );
+
+		bool Matches( FStringView Value ) const;
+	};
+
+	struct FCompiledRule
+	{
+		FPattern Section;
+		FPattern Key;
+		bool     bExclude = true;
+	};
+
+	TArray< FCompiledRule > CompiledRules;
+	bool                    bHasExcludeRules = false;
+};
\ No newline at end of file
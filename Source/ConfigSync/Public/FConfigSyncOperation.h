@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+class FConfigSyncOperation
+{
+public:
+	using FWork        = TFunction< void( FConfigSyncOperation& Operation ) >;
+	using FOnCompleted = TFunction< void( bool bCancelled ) >;
+
+	FConfigSyncOperation( const FText& InDescription, int32 InFilesTotal );
+
+	// Runs Work on the thread pool and OnCompleted from the core ticker on the game thread once Work returns.
+	static TSharedRef< FConfigSyncOperation > Launch( const FText& Description, int32 FilesTotal, FWork Work, FOnCompleted OnCompleted );
+
+	void Cancel() { bCancelRequested = true; }
+
+	// Cancels, blocks until Work has returned and drops OnCompleted, so nothing of the operation runs after the module shuts down.
+	void CancelAndWait();
+
+	bool IsCancelled() const { return bCancelRequested; }
+	bool IsRunning() const { return bRunning; }
+
+	void AddProgress( int32 Files, int64 Bytes );
+
+	TOptional< float > GetProgressFraction() const;
+	FText              GetProgressText() const;
+
+private:
+	FText Description;
+
+	TFuture< void >            WorkFuture;
+	FTSTicker::FDelegateHandle CompletionHandle;
+
+	std::atomic< int32 > FilesDone        = 0;
+	std::atomic< int32 > FilesTotal       = 0;
+	std::atomic< int64 > BytesDone        = 0;
+	std::atomic< bool >  bCancelRequested = false;
+	std::atomic< bool >  bRunning         = true;
+};
\ No newline at end of file
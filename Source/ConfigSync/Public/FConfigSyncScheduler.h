@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FConfigSyncScheduler
+{
+public:
+	void SetIntervals( double InMinInterval, double InMaxInterval );
+
+	bool Contains( const FString& FileId ) const { return Intervals.Contains( FileId ); }
+
+	void Add( const FString& FileId, double Now, double InitialInterval );
+
+	// Drops every file that is not in FileIds. The files that remain keep their learned interval and next check time.
+	void Retain( const TSet< FString >& FileIds );
+
+	// Pops at most Budget files whose check time has passed. Only due files are touched, so the cost per tick follows file activity rather than the number of tracked files.
+	void PopDue( double Now, int32 Budget, TArray< FString >& OutDueFiles );
+
+	// Changed files drop back to the minimum interval, unchanged files back off exponentially up to the maximum interval.
+	void Reschedule( const FString& FileId, double Now, bool bChanged );
+
+private:
+	struct FScheduledFile
+	{
+		double  NextCheckTime = 0;
+		FString FileId;
+
+		bool operator<( const FScheduledFile& Other ) const { return NextCheckTime < Other.NextCheckTime; }
+	};
+
+	TArray< FScheduledFile > Queue;
+	TMap< FString, double >  Intervals;
+
+	double MinInterval = 2;
+	double MaxInterval = 3600;
+};
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Async/Future.h"
+#include "CoreMinimal.h"
+#include "FConfigSyncIni.h"
+#include "Misc/ScopeLock.h"
+
+class IFileHandle;
+
+// A point in a stored file's history. The generation is new every time the file is created from scratch, so a sequence pulled from a deleted predecessor never
+// matches the file that replaced it.
+struct FConfigSyncStoreHead
+{
+	FString Generation;
+	int64   Sequence = INDEX_NONE;
+};
+
+// A stored ini is a compacted base file plus an append-only log of key-level deltas next to it (<File>.delta, one JSON record per line). When the log starts with
+// a record without changes, that record holds the generation and the sequence the base was compacted at. Deltas replace whole keys, so replaying one that is
+// already part of the base is harmless.
+//
+// A directory can inherit from a parent directory: files it does not hold itself are read from the nearest ancestor that does, and a write only copies the
+// inherited file into the directory once its contents actually diverge.
+class FConfigSyncStore
+{
+public:
+	// Serializes store access between threads and between every editor on the machine. The cross-process half is an exclusively opened lock file, which the OS
+	// releases even if the owning editor crashes.
+	class FScopedLock
+	{
+	public:
+		FScopedLock();
+		~FScopedLock();
+
+		bool IsLocked() const { return bLocked; }
+
+	private:
+		FScopeLock                ThreadLock;
+		TUniquePtr< IFileHandle > FileHandle;
+		bool                      bLocked = false;
+	};
+
+	static void SetLockFilePath( const FString& InLockFilePath );
+
+	// Blocks until every queued background compaction has finished.
+	static void WaitForCompactions();
+
+	// Materializes the base file with every recorded delta applied.
+	static bool Read( const FString& StorePath, FString& OutContents, FConfigSyncStoreHead* OutHead = nullptr );
+
+	// Appends the key-level difference between the stored contents and NewContents as one delta, and schedules a background compaction once the log grows past
+	// CompactionThreshold deltas.
+	static bool Write( const FString& StorePath, const FString& NewContents );
+
+	// Returns false when the file was recreated since Since was pulled or the deltas after it were compacted into the base, in which case the caller has to Read the
+	// full file instead.
+	static bool ReadChangesSince( const FString& StorePath, const FConfigSyncStoreHead& Since, TArray< FConfigSyncIniChange >& OutChanges, FConfigSyncStoreHead& OutHead );
+
+	static void Compact( const FString& StorePath );
+
+	static void SetParentDirectory( const FString& Directory, const FString& ParentDirectory );
+
+private:
+	struct FDelta
+	{
+		int64                          Sequence = 0;
+		FString                        Generation;
+		TArray< FConfigSyncIniChange > Changes;
+	};
+
+	static bool    CreateBase( const FString& StorePath, const FString& Contents );
+	static void    ScheduleCompaction( const FString& StorePath );
+	static FString ResolvePath( const FString& StorePath );
+	static bool    ReadFile( const FString& Path, FString& OutContents, FConfigSyncStoreHead& OutHead );
+
+	static void                 LoadDeltas( const FString& StorePath, FConfigSyncStoreHead& OutBase, TArray< FDelta >& OutDeltas );
+	static FConfigSyncStoreHead GetHead( const FConfigSyncStoreHead& Base, const TArray< FDelta >& Deltas );
+	static void Materialize( const FString& Base, const TArray< FDelta >& Deltas, FString& OutContents );
+
+	static FString SerializeDelta( const FDelta& Delta );
+	static bool    DeserializeDelta( const FString& Line, FDelta& OutDelta );
+
+	static FString GetDeltaLogPath( const FString& StorePath ) { return StorePath + TEXT( ".delta" ); }
+
+	static constexpr int32  CompactionThreshold = 32;
+	static constexpr double LockTimeout         = 30;
+
+	static TMap< FString, TFuture< void > > Compactions;
+	static FString                          LockFilePath;
+	static TMap< FString, FString >         ParentDirectories;
+	static FCriticalSection                 StoreLock;
+};
\ No newline at end of file
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "FConfigSyncHotApply.h"
+#include "FConfigSyncKeyFilter.h"
+#include "FConfigSyncOperation.h"
+#include "FConfigSyncScheduler.h"
+#include "FConfigSyncStore.h"
 #include "UObject/Object.h"
 
 #include "UConfigSyncSettings.generated.h"
@@ -34,6 +39,24 @@ struct FConfigFileSettings
 	bool bAutoSyncEnabled = true;
 };
 
+USTRUCT( BlueprintType )
+struct FConfigSyncKeyRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY( EditAnywhere )
+	FString File = TEXT( "*" );
+
+	UPROPERTY( EditAnywhere )
+	FString Section = TEXT( "*" );
+
+	UPROPERTY( EditAnywhere )
+	FString Key;
+
+	UPROPERTY( EditAnywhere )
+	bool bExclude = true;
+};
+
 USTRUCT()
 struct FConfigFileSettingsStruct
 {
@@ -41,6 +64,91 @@ struct FConfigFileSettingsStruct
 
 	UPROPERTY( EditAnywhere )
 	TArray< FConfigFileSettings > Settings;
+
+	UPROPERTY( EditAnywhere )
+	bool bHotApplyOnLoad = true;
+
+	UPROPERTY( EditAnywhere )
+	TArray< FConfigSyncKeyRule > KeyRules;
+
+	UPROPERTY( EditAnywhere, meta = ( ClampMin = "0.1", Units = "s" ) )
+	float AutoSyncMinInterval = 2;
+
+	UPROPERTY( EditAnywhere, meta = ( ClampMin = "0.1", Units = "s" ) )
+	float AutoSyncMaxInterval = 3600;
+
+	UPROPERTY( EditAnywhere, meta = ( ClampMin = "1" ) )
+	int32 AutoSyncFilesPerTick = 8;
+};
+
+USTRUCT()
+struct FConfigSyncPulledFile
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString Generation;
+
+	UPROPERTY()
+	int64 Sequence = INDEX_NONE;
+};
+
+// Store head each file was last pulled at. This is per-checkout state, so it lives in the project's Saved directory rather than in the settings shared by every
+// checkout of the same project.
+USTRUCT()
+struct FConfigSyncPulledSequences
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TMap< FString, FConfigSyncPulledFile > Files;
+};
+
+USTRUCT()
+struct FConfigSyncRegisteredProject
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString ProjectName;
+
+	UPROPERTY()
+	FString ProjectDir;
+
+	UPROPERTY()
+	FString EngineVersion;
+};
+
+USTRUCT()
+struct FConfigSyncProjectRegistry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray< FConfigSyncRegisteredProject > Projects;
+};
+
+struct FConfigSyncFanOutResult
+{
+	FString ProjectName;
+	FString ProjectDir;
+	int32   FilesApplied = 0;
+	int32   FilesFailed  = 0;
+};
+
+struct FConfigSyncFileState
+{
+	FDateTime         SourceTimestamp;
+	int64             SourceSize = INDEX_NONE;
+	TOptional<uint64> SourceHash;
+};
+
+struct FConfigSyncFileJob
+{
+	FString              Source;
+	FString              Destination;
+	FConfigSyncKeyFilter KeyFilter;
+	FConfigSyncStoreHead PulledHead;
 };
 
 UCLASS()
@@ -51,12 +159,27 @@ class CONFIGSYNC_API UConfigSyncSettings : public UObject
 public:
 	static UConfigSyncSettings* Get();
 
-	void Initialize() { EnableAutoSync(); }
-	void Shutdown() const { DisableAutoSync(); }
+	void Initialize()
+	{
+		RegisterProject();
+		EnableAutoSync();
+	}
+	void Shutdown();
 
-	void DiscoverAndAddConfigFiles();
-	void SaveSettingsToGlobal();
-	void LoadSettingsFromGlobal();
+	void                      DiscoverAndAddConfigFiles();
+	void                      SaveSettingsToGlobal();
+	FConfigSyncHotApplyResult LoadSettingsFromGlobal();
+
+	// Asynchronous variants run the file I/O on the thread pool and return null while another operation is still running.
+	TSharedPtr< FConfigSyncOperation > DiscoverAndAddConfigFilesAsync( TFunction< void() > OnCompleted );
+	TSharedPtr< FConfigSyncOperation > SaveSettingsToGlobalAsync( TFunction< void() > OnCompleted );
+	TSharedPtr< FConfigSyncOperation > LoadSettingsFromGlobalAsync( TFunction< void( const FConfigSyncHotApplyResult& ) > OnCompleted );
+
+	// Saves to global once, then pulls the pushed files into every other registered project that syncs them to the same store path, one project per worker.
+	TSharedPtr< FConfigSyncOperation > FanOutToProjectsAsync( TFunction< void( const TArray< FConfigSyncFanOutResult >& ) > OnCompleted );
+
+	TSharedPtr< FConfigSyncOperation > GetActiveOperation() const { return ActiveOperation; }
+	bool                               IsOperationRunning() const { return ActiveOperation.IsValid() && ActiveOperation->IsRunning(); }
 
 	void OnSettingsChanged();
 
@@ -64,21 +187,64 @@ public:
 	FConfigFileSettingsStruct ConfigFileSettingsStruct;
 
 private:
-	void SavePluginSettings() const;
-	void LoadPluginSettings();
+	void FinishOperation();
+
+	void AddConfigFiles( TArray< FString >& ConfigPaths );
+	void BuildFileJobs( bool bToGlobal, TArray< FConfigSyncFileJob >& OutJobs );
+
+	static void FindConfigFiles( TArray< FString >& OutConfigPaths, FConfigSyncOperation* Operation );
+	void StorePulledSequences( const TArray< FConfigSyncFileJob >& Jobs );
+
+	static bool PullFile( FConfigSyncFileJob& Job, bool bHotApply, TArray< FConfigSyncFileChanges >& OutChanges );
+
+	void        SavePluginSettings() const;
+	void        LoadPluginSettings();
+	void        SavePulledSequences() const;
+	void        LoadPulledSequences();
+	static bool LoadSettingsFile( const FString& SettingsFilePath, FConfigFileSettingsStruct& OutSettings );
+
+	static void ConfigureEngineVersionInheritance();
+	static void RegisterProject();
+	static bool LoadProjectRegistry( FConfigSyncProjectRegistry& OutRegistry );
+	static void SaveProjectRegistry( const FConfigSyncProjectRegistry& Registry );
+	static void BuildFanOutJobs( const FConfigSyncRegisteredProject& Project, const TSet< FString >& StorePaths, TArray< FConfigSyncFileJob >& OutJobs );
 
 	void EnableAutoSync();
 	void DisableAutoSync() const;
 
 	bool AutoSyncTick( float DeltaTime );
+	bool AutoSyncFile( const FConfigFileSettings& Setting );
+	void RebuildAutoSyncSchedule();
 
-	static bool CopyIniFile( const FString& Source, const FString& Destination );
+	const FConfigSyncKeyFilter& GetKeyFilter( const FConfigFileSettings& Setting );
+
+	static bool PushIniFile( const FString& Source, const FString& StorePath, const FConfigSyncKeyFilter& KeyFilter );
+	static bool PullIniFile( const FString& StorePath, const FString& Destination, const FConfigSyncKeyFilter& KeyFilter, FConfigSyncStoreHead& InOutHead );
+	static bool SaveIniFile( const FString& Destination, const FString* OldContents, const FString& NewContents );
 	static bool EnsureDirectoryExists( const FString& DirectoryPath );
 
+	static FString GetBaseSettingsDirectory();
 	static FString GetScopedSettingsDirectory( EConfigSyncScope Scope );
+	static FString GetScopedSettingsDirectory( EConfigSyncScope Scope, const FString& EngineVersion, const FString& ProjectName );
 	static FString GetPluginSettingsFilePath();
+	static FString GetPluginSettingsFilePath( const FString& ProjectName );
+	static FString GetProjectRegistryFilePath();
+	static FString GetPulledSequencesFilePath();
+	static FString GetEngineVersionName();
+	static FString GetFullProjectDir();
 
 	FTSTicker::FDelegateHandle AutoSyncHandle;
 
+	TSharedPtr< FConfigSyncOperation > ActiveOperation;
+	bool                               bSettingsChangedDuringOperation = false;
+
+	FConfigSyncPulledSequences PulledSequences;
+
+	TMap< FString, FConfigSyncKeyFilter > KeyFilters;
+	TMap< FString, FConfigSyncFileState > FileStates;
+	FConfigSyncScheduler                  AutoSyncScheduler;
+	TMap< FString, int32 >                AutoSyncSettingIndices;
+	bool                                  bAutoSyncScheduleDirty = true;
+
 	static UConfigSyncSettings* Instance;
 };
\ No newline at end of file